@@ -0,0 +1,54 @@
+#pragma once
+#ifndef RIFT_BENCH_HPP
+#define RIFT_BENCH_HPP
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace rift::bench {
+
+    struct Benchmark {
+        std::string name;
+        size_t iterations;
+        std::function<void()> body;
+    };
+
+    /// @brief Returns all benchmarks registered with RIFT_BENCHMARK.
+    inline std::vector<Benchmark>& registry() {
+        static std::vector<Benchmark> benchmarks;
+        return benchmarks;
+    }
+
+    struct Registrar {
+        Registrar(std::string name, size_t iterations, std::function<void()> body) {
+            registry().push_back({ std::move(name), iterations, std::move(body) });
+        }
+    };
+
+    /// @brief Returns the number of heap allocations made by the process so far.
+    /// Counted by the replacement operator new in alloc.cpp.
+    size_t allocationCount() noexcept;
+
+    /// @brief Prevents the compiler from discarding a computed value.
+    template <typename T>
+    void doNotOptimize(T const& value) {
+#if defined(__GNUC__) || defined(__clang__)
+        asm volatile("" : : "r"(&value) : "memory");
+#else
+        static void const* volatile sink;
+        sink = &value;
+#endif
+    }
+
+}
+
+#define RIFT_BENCH_CONCAT_(a, b) a##b
+#define RIFT_BENCH_CONCAT(a, b) RIFT_BENCH_CONCAT_(a, b)
+
+/// @brief Registers a benchmark body that is run a fixed number of times.
+#define RIFT_BENCHMARK(name, iterations, ...) \
+    static rift::bench::Registrar RIFT_BENCH_CONCAT(benchmark_, __LINE__)(name, iterations, __VA_ARGS__)
+
+#endif // RIFT_BENCH_HPP
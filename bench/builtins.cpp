@@ -0,0 +1,49 @@
+#include "bench.hpp"
+
+#include <rift/config.hpp>
+
+// Calls every builtin registered by Config directly, with arguments it accepts.
+
+namespace {
+
+    struct BuiltinCall {
+        std::string_view name;
+        std::vector<rift::Value> args;
+    };
+
+    std::vector<BuiltinCall> const& calls() {
+        static std::vector<BuiltinCall> const calls = {
+            {"int", {"100"}}, {"float", {"3.14"}}, {"str", {3.1415926}},
+            {"len", {"Hello, World!"}}, {"toUpper", {"Hello, World!"}}, {"toLower", {"Hello, World!"}},
+            {"substr", {"Hello, World!", 7, 5}}, {"trim", {"  Hello, World!  "}},
+            {"replace", {"Hello, World!", "World", "Universe"}}, {"find", {"Hello, World!", "World"}},
+            {"round", {3.6}}, {"floor", {3.6}}, {"ceil", {3.4}}, {"precision", {3.149268, 3}},
+            {"ordinal", {23}}, {"duration", {123.456}},
+            {"randomInt", {1, 100}}, {"randomFloat", {0.0, 1.0}}, {"random", {1, 100}},
+            {"middlePad", {"abc", 20, "-"}}, {"leftPad", {"abc", 20, "-"}}, {"rightPad", {"abc", 20, "-"}},
+            {"min", {3, 1, 2}}, {"max", {3, 1, 2}}, {"sum", {1, 2.5, 3}}, {"avg", {1, 2.5, 3}},
+            {"sqrt", {2.0}}, {"cbrt", {27.0}}, {"abs", {-2.5}},
+            {"sin", {0.5}}, {"cos", {0.5}}, {"tan", {0.5}}, {"asin", {0.5}}, {"acos", {0.5}}, {"atan", {0.5}},
+            {"sinh", {0.5}}, {"cosh", {0.5}}, {"tanh", {0.5}}, {"asinh", {0.5}}, {"acosh", {1.5}}, {"atanh", {0.5}},
+            {"exp", {0.5}}, {"log", {0.5}}, {"log10", {0.5}},
+            {"pow", {2.0, 10.0}}, {"hypot", {3.0, 4.0}}, {"atan2", {1.0, 2.0}},
+            {"ord", {23}}, {"lpad", {"abc", 20, "-"}}, {"mpad", {"abc", 20, "-"}}, {"rpad", {"abc", 20, "-"}},
+            {"prec", {3.149268, 3}}, {"rand", {1, 100}},
+        };
+        return calls;
+    }
+
+    struct Register {
+        Register() {
+            for (auto const& call : calls()) {
+                auto const* function = rift::Config::get().getFunction(call.name);
+                if (!function) continue;
+                rift::bench::registry().push_back({
+                    fmt::format("builtin/{}", call.name), 200'000,
+                    [function, &call] { rift::bench::doNotOptimize((*function)(call.args)); }
+                });
+            }
+        }
+    } const REGISTER;
+
+}
@@ -0,0 +1,37 @@
+#include "bench.hpp"
+
+#include <rift.hpp>
+
+// Compiles and destroys a batch of templates, measures parser and node allocation overhead.
+
+namespace {
+
+    constexpr size_t TEMPLATE_COUNT = 10'000;
+
+    std::vector<std::string> const& templates() {
+        static std::vector<std::string> sources = [] {
+            std::vector<std::string> result;
+            result.reserve(TEMPLATE_COUNT);
+            for (size_t i = 0; i < TEMPLATE_COUNT; ++i) {
+                result.push_back(fmt::format(
+                    "Player {{name}} #{}: {{health > {} ? 'alive' : 'dead'}} at {{player.x * {} + offset[{}]}} "
+                    "({{middlePad(str(progress), 10, '-')}}%)",
+                    i, i % 100, i % 7 + 1, i % 3
+                ));
+            }
+            return result;
+        }();
+        return sources;
+    }
+
+    void compileAll(rift::OptimizationLevel level) {
+        for (auto const& source : templates()) {
+            auto script = rift::compile(source, false, level);
+            rift::bench::doNotOptimize(script);
+        }
+    }
+
+    RIFT_BENCHMARK("compile/10k-templates", 10, [] { compileAll(rift::OptimizationLevel::Basic); });
+    RIFT_BENCHMARK("compile/10k-templates/unoptimized", 10, [] { compileAll(rift::OptimizationLevel::None); });
+
+}
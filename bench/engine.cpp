@@ -0,0 +1,86 @@
+#include "bench.hpp"
+
+#include <rift.hpp>
+
+// Tree-walking Visitor vs. bytecode Chunk on the same compiled scripts.
+
+namespace {
+
+    rift::Object const VARIABLES = {
+        {"name", "World"},
+        {"number", 2},
+        {"progress", 50},
+        {"player", rift::Object {{"x", 12.5}, {"y", -3.25}}},
+        {"level", rift::Object {{"players", rift::Array {
+            rift::Object {{"stats", rift::Object {{"position", rift::Object {{"x", 1.5}, {"y", 2.5}}}}}},
+        }}}},
+    };
+
+    std::unique_ptr<rift::Script> compile(std::string_view source, rift::Script::Engine engine) {
+        auto script = std::move(rift::compile(source).unwrap());
+        script->setEngine(engine);
+        return script;
+    }
+
+    void registerPair(std::string const& name, std::string_view source) {
+        for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+            auto suffix = engine == rift::Script::Engine::TreeWalker ? "tree" : "bytecode";
+            std::shared_ptr script = compile(source, engine);
+            rift::bench::registry().push_back({
+                fmt::format("engine/{}/{}", name, suffix), 200'000,
+                [script] { rift::bench::doNotOptimize(script->run(VARIABLES)); }
+            });
+        }
+    }
+
+    // rendering into a reused buffer should not allocate at all once it has grown
+    void registerSink(std::string const& name, std::string_view source) {
+        for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+            auto suffix = engine == rift::Script::Engine::TreeWalker ? "tree" : "bytecode";
+            std::shared_ptr script = compile(source, engine);
+            auto buffer = std::make_shared<std::string>();
+            rift::bench::registry().push_back({
+                fmt::format("engine/{}/runInto/{}", name, suffix), 200'000,
+                [script, buffer] { rift::bench::doNotOptimize(script->runInto(*buffer, VARIABLES)); }
+            });
+        }
+    }
+
+    // the same frame through a schema without and with declared types, the latter picks arithmetic kernels
+    void registerTyped(std::string_view source) {
+        rift::VariableSchema untyped = {"number", "speed"};
+        rift::VariableSchema typed;
+        typed.add("number", rift::Value::Type::Integer);
+        typed.add("speed", rift::Value::Type::Float);
+        auto frame = std::make_shared<std::vector<rift::Value>>(std::vector<rift::Value> {2, 1.5});
+        for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+            auto suffix = engine == rift::Script::Engine::TreeWalker ? "tree" : "bytecode";
+            for (auto const* schema : {&untyped, &typed}) {
+                std::shared_ptr script = std::move(rift::compile(source, *schema).unwrap());
+                script->setEngine(engine);
+                auto buffer = std::make_shared<std::string>();
+                rift::bench::registry().push_back({
+                    fmt::format("engine/{}/{}", schema == &typed ? "typed" : "untyped", suffix), 200'000,
+                    [script, buffer, frame] { rift::bench::doNotOptimize(script->runInto(*buffer, *frame)); }
+                });
+            }
+        }
+    }
+
+    struct Register {
+        Register() {
+            registerPair("segments", "Hello, {name}! You are {progress}% done.");
+            registerPair("arithmetic", "{(number + 2 * number) * 3 - number / 2 ^ 2}");
+            registerPair("ternary", "{number > 1 ? (number == 2 ? 'two' : 'many') : 'one'}");
+            registerPair("call", "{middlePad('#' * (progress * 4 / 10), 40, '-')} {progress}%");
+            registerPair("accessor", "X: {player.x} Y: {player.y}");
+            registerPair("path", "{level.players[0].stats.position.x + level.players[0].stats.position.y}");
+            registerSink("path", "X: {level.players[0].stats.position.x} Y: {level.players[0].stats.position.y}");
+            registerPair("concat", "{name + ' has ' + progress + '% of ' + name + '\\'s progress, ' + number + ' left'}");
+            registerSink("segments", "Hello, {name}! You are {progress}% done.");
+            registerTyped("{(number + 2 * number) * 3 - number / 2 ^ 2} {speed * number > 2.5} {number % 3 == 2}");
+            registerSink("numbers", "X: {player.x * 2} Y: {player.y} N: {number * 1000} P: {progress}%");
+        }
+    } const REGISTER;
+
+}
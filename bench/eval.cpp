@@ -0,0 +1,44 @@
+#include "bench.hpp"
+
+#include <rift.hpp>
+
+// Script::eval for every Node::Type, compiled without optimizations so the node under test survives.
+
+namespace {
+
+    rift::Object const VARIABLES = {
+        {"name", "World"},
+        {"number", 2},
+        {"flag", true},
+        {"player", rift::Object {{"x", 12.5}, {"y", -3.25}}},
+        {"items", rift::Array {1, 2, 3, 4}},
+    };
+
+    void registerEval(std::string_view type, std::string_view source, bool directMode = true) {
+        for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+            auto suffix = engine == rift::Script::Engine::TreeWalker ? "tree" : "bytecode";
+            std::shared_ptr script = std::move(rift::compile(source, directMode, rift::OptimizationLevel::None).unwrap());
+            script->setEngine(engine);
+            rift::bench::registry().push_back({
+                fmt::format("eval/{}/{}", type, suffix), 200'000,
+                [script] { rift::bench::doNotOptimize(script->eval(VARIABLES)); }
+            });
+        }
+    }
+
+    struct Register {
+        Register() {
+            registerEval("segment", "Hello, World!", false);
+            registerEval("root", "Hello, {name}! {number}", false);
+            registerEval("value", "42");
+            registerEval("identifier", "name");
+            registerEval("binary", "number * 3");
+            registerEval("unary", "-number");
+            registerEval("ternary", "flag ? 'yes' : 'no'");
+            registerEval("call", "len(name)");
+            registerEval("accessor", "player.x");
+            registerEval("indexer", "items[2]");
+        }
+    } const REGISTER;
+
+}
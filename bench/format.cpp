@@ -0,0 +1,31 @@
+#include "bench.hpp"
+
+#include <rift.hpp>
+
+// rift::format end to end: cache lookup, evaluation and result string, the way most callers use rift.
+
+namespace {
+
+    rift::Object const VARIABLES = {
+        {"name", "World"},
+        {"progress", 50},
+        {"player", rift::Object {{"x", 12.5}, {"y", -3.25}}},
+    };
+
+    RIFT_BENCHMARK("format/static", 200'000, [] {
+        rift::bench::doNotOptimize(rift::format("Hello, World!"));
+    });
+
+    RIFT_BENCHMARK("format/variables", 200'000, [] {
+        rift::bench::doNotOptimize(rift::format("Hello, {name}! X: {player.x} Y: {player.y}", VARIABLES));
+    });
+
+    RIFT_BENCHMARK("format/progress", 200'000, [] {
+        rift::bench::doNotOptimize(rift::format("{middlePad('#' * (progress * 4 / 10), 40, '-')} {progress}%", VARIABLES));
+    });
+
+    RIFT_BENCHMARK("evaluate/expression", 200'000, [] {
+        rift::bench::doNotOptimize(rift::evaluate("player.x * 2 + player.y > 10 ? name : 'nobody'", VARIABLES));
+    });
+
+}
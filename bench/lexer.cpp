@@ -0,0 +1,28 @@
+#include "bench.hpp"
+
+#include <rift/lexer.hpp>
+
+// Tokenizes whole templates, tokens are views into the source so this should not allocate at all.
+
+namespace {
+
+    void lexAll(std::string_view source) {
+        rift::Lexer lexer(source);
+        while (true) {
+            auto token = lexer.next();
+            if (token.isErr() || !token.unwrap()) {
+                break;
+            }
+            rift::bench::doNotOptimize(token);
+        }
+    }
+
+    RIFT_BENCHMARK("lexer/template", 200'000, [] {
+        lexAll("Player {name} #42: {health > 50 ? 'alive' : 'dead'} at {player.x * 3 + offset[1]} ({progress}%)");
+    });
+
+    RIFT_BENCHMARK("lexer/escaped", 200'000, [] {
+        lexAll("Line one\\nLine two {'tab\\there'} {\"quote \\\" inside\"}");
+    });
+
+}
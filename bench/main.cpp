@@ -0,0 +1,84 @@
+#include "bench.hpp"
+
+#include <chrono>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace {
+
+    struct Result {
+        std::string_view name;
+        size_t iterations;
+        double nanoseconds;
+        double allocations;
+    };
+
+    Result run(rift::bench::Benchmark const& benchmark) {
+        // warm up caches and lazily initialized state before timing
+        benchmark.body();
+
+        auto allocations = rift::bench::allocationCount();
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < benchmark.iterations; ++i) {
+            benchmark.body();
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+        allocations = rift::bench::allocationCount() - allocations;
+
+        return {
+            benchmark.name, benchmark.iterations,
+            elapsed / benchmark.iterations, static_cast<double>(allocations) / benchmark.iterations
+        };
+    }
+
+}
+
+/// Usage: rift_bench [--json] [filter]
+/// With --json the results are printed as a JSON array, so the output of two builds can be diffed.
+int main(int argc, char** argv) {
+    std::string_view filter;
+    bool json = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        if (arg == "--json") {
+            json = true;
+        } else {
+            filter = arg;
+        }
+    }
+
+    if (json) {
+        fmt::print("[");
+    } else {
+        fmt::print("{:<48} {:>12} {:>14} {:>14}\n", "benchmark", "iterations", "ns/iteration", "allocs/iter");
+    }
+
+    bool first = true;
+    for (auto const& benchmark : rift::bench::registry()) {
+        if (!filter.empty() && benchmark.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        auto result = run(benchmark);
+        if (json) {
+            // benchmark names are plain ascii paths, nothing in them needs escaping
+            fmt::print(
+                "{}\n  {{\"name\": \"{}\", \"iterations\": {}, \"ns_per_iteration\": {:.1f}, \"allocs_per_iteration\": {:.2f}}}",
+                first ? "" : ",", result.name, result.iterations, result.nanoseconds, result.allocations
+            );
+        } else {
+            fmt::print(
+                "{:<48} {:>12} {:>14.1f} {:>14.1f}\n", result.name, result.iterations,
+                result.nanoseconds, result.allocations
+            );
+        }
+        first = false;
+    }
+
+    if (json) {
+        fmt::print("\n]\n");
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+#include "bench.hpp"
+
+#include <rift.hpp>
+
+// Exposing a host struct to a template: rebuilding an Object every frame vs. a native handle.
+
+namespace {
+
+    struct Player {
+        double x = 12.5;
+        double y = -3.25;
+        double rotation = 90;
+        int64_t attempts = 12;
+        int64_t jumps = 340;
+        bool dead = false;
+    };
+
+    Player PLAYER;
+
+    constexpr rift::NativeProperty PLAYER_PROPERTIES[] = {
+        {"x", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->x; }},
+        {"y", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->y; }},
+        {"rotation", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->rotation; }},
+        {"attempts", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->attempts; }},
+        {"jumps", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->jumps; }},
+        {"dead", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->dead; }},
+    };
+    rift::NativeType const PLAYER_TYPE("Player", PLAYER_PROPERTIES);
+
+    constexpr std::string_view SOURCE = "X: {player.x} Y: {player.y}";
+
+    void registerFrame(rift::Script::Engine engine) {
+        auto suffix = engine == rift::Script::Engine::TreeWalker ? "tree" : "bytecode";
+        std::shared_ptr script = std::move(rift::compile(SOURCE).unwrap());
+        script->setEngine(engine);
+        auto buffer = std::make_shared<std::string>();
+
+        // what hosts had to do before: copy every field, whether the template reads it or not
+        rift::bench::registry().push_back({
+            fmt::format("native/object/{}", suffix), 200'000,
+            [script, buffer] {
+                rift::Object variables {{"player", rift::Object {
+                    {"x", PLAYER.x}, {"y", PLAYER.y}, {"rotation", PLAYER.rotation},
+                    {"attempts", PLAYER.attempts}, {"jumps", PLAYER.jumps}, {"dead", PLAYER.dead},
+                }}};
+                rift::bench::doNotOptimize(script->runInto(*buffer, variables));
+            }
+        });
+
+        auto variables = std::make_shared<rift::Object>(rift::Object {{"player", rift::Value::native(&PLAYER, PLAYER_TYPE)}});
+        rift::bench::registry().push_back({
+            fmt::format("native/handle/{}", suffix), 200'000,
+            [script, buffer, variables] { rift::bench::doNotOptimize(script->runInto(*buffer, *variables)); }
+        });
+    }
+
+    struct Register {
+        Register() {
+            registerFrame(rift::Script::Engine::TreeWalker);
+            registerFrame(rift::Script::Engine::Bytecode);
+        }
+    } const REGISTER;
+
+}
@@ -0,0 +1,54 @@
+#include "bench.hpp"
+
+#include <rift/util.hpp>
+#include <rift/value.hpp>
+
+#include <clocale>
+#include <cstdlib>
+
+// util::fromChars against the setlocale + strtod path readNumber used to take for floats.
+
+namespace {
+
+    constexpr std::string_view NUMBERS[] = {
+        "144.0", "3.14159", "-0.5", "1e5", "100", "60.0", "0.016666", "12345.678"
+    };
+
+    double legacyParse(std::string_view str) {
+        std::string buffer(str);
+        char* end;
+        std::setlocale(LC_NUMERIC, "C");
+        return std::strtod(buffer.c_str(), &end);
+    }
+
+    double parseAll() {
+        double sum = 0;
+        for (auto number : NUMBERS) {
+            double value = 0;
+            (void) rift::util::fromChars(number, value);
+            sum += value;
+        }
+        return sum;
+    }
+
+    double legacyParseAll() {
+        double sum = 0;
+        for (auto number : NUMBERS) {
+            sum += legacyParse(number);
+        }
+        return sum;
+    }
+
+    rift::Value const STRING_NUMBER = "144.0";
+    rift::Value const FLOAT_NUMBER = 144.0;
+
+    RIFT_BENCHMARK("number/parse/fromChars", 1'000'000, [] { rift::bench::doNotOptimize(parseAll()); });
+    RIFT_BENCHMARK("number/parse/legacy", 1'000'000, [] { rift::bench::doNotOptimize(legacyParseAll()); });
+    RIFT_BENCHMARK("number/parse/readNumber", 1'000'000, [] {
+        rift::bench::doNotOptimize(rift::util::readNumber<double>("12345.678"));
+    });
+    RIFT_BENCHMARK("number/coerce/equal", 1'000'000, [] {
+        rift::bench::doNotOptimize(STRING_NUMBER == FLOAT_NUMBER);
+    });
+
+}
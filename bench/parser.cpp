@@ -0,0 +1,51 @@
+#include "bench.hpp"
+
+#include <rift/parser.hpp>
+
+#include <string>
+
+// Parses templates into a fresh arena, without optimizing or binding calls.
+
+namespace {
+
+    void parse(std::string_view source, bool directMode = false) {
+        rift::Arena arena;
+        rift::Parser parser(rift::Lexer(source, directMode), arena, directMode);
+        auto result = parser.parse();
+        rift::bench::doNotOptimize(result);
+    }
+
+    RIFT_BENCHMARK("parser/template", 100'000, [] {
+        parse("Player {name} #42: {health > 50 ? 'alive' : 'dead'} at {player.x * 3 + offset[1]} ({progress}%)");
+    });
+
+    RIFT_BENCHMARK("parser/expression", 100'000, [] {
+        parse("(number + 2 * number) * 3 - number / 2 ^ 2 == 7 && !flag || value ?? 'fallback'", true);
+    });
+
+    RIFT_BENCHMARK("parser/nested", 100'000, [] {
+        parse("((((a + 1) * (b - 2)) / ((c ^ 2) % 3)) + f(g(h(x[y[z[0]]])), -(-(-w)))) ? (p ?? (q ?? r)) : s.t.u", true);
+    });
+
+    RIFT_BENCHMARK("parser/chain", 10'000, [] {
+        static auto const source = [] {
+            std::string source = "x";
+            for (size_t i = 0; i < 200; ++i) {
+                source += " + x * 2 - y.z / 3";
+            }
+            return source;
+        }();
+        parse(source, true);
+    });
+
+    // must be rejected at the depth limit without touching the call stack
+    RIFT_BENCHMARK("parser/too-deep", 10'000, [] {
+        static auto const source = std::string(10'000, '(') + "1" + std::string(10'000, ')');
+        parse(source, true);
+    });
+
+    RIFT_BENCHMARK("parser/calls", 100'000, [] {
+        parse("{middlePad('#' * (progress * 4 / 10), 40, '-')} {min(1, 2, 3)} {precision(sqrt(2), 4)}");
+    });
+
+}
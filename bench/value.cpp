@@ -0,0 +1,61 @@
+#include "bench.hpp"
+
+#include <rift/value.hpp>
+
+// Value operators on their own, without any parsing or evaluation around them.
+
+namespace {
+
+    rift::Value const INTEGER = 1234;
+    rift::Value const OTHER_INTEGER = 56;
+    rift::Value const FLOAT = 12.5;
+    rift::Value const STRING = "Hello, World!";
+    rift::Value const OTHER_STRING = "World";
+    rift::Value const BOOLEAN = true;
+    rift::Value const ARRAY = [] {
+        rift::Array array;
+        for (int i = 0; i < 1000; ++i) {
+            array.emplace_back(i % 3 == 0 ? rift::Value(i) : i % 3 == 1 ? rift::Value(i * 0.5) : rift::Value("item"));
+        }
+        return rift::Value(std::move(array));
+    }();
+
+    // touches every element, so the cost is dominated by the size and layout of Value
+    int64_t sumArray() {
+        int64_t sum = 0;
+        for (auto const& item : ARRAY.getArray()) {
+            sum += item.isString() ? static_cast<int64_t>(item.getStringView().size()) : item.toInteger();
+        }
+        return sum;
+    }
+
+#define RIFT_VALUE_BENCHMARK(name, expr) \
+    RIFT_BENCHMARK("value/" name, 1'000'000, [] { \
+        auto result = expr; \
+        rift::bench::doNotOptimize(result); \
+    })
+
+    RIFT_VALUE_BENCHMARK("add/integer", INTEGER + OTHER_INTEGER);
+    RIFT_VALUE_BENCHMARK("add/float", INTEGER + FLOAT);
+    RIFT_VALUE_BENCHMARK("add/string", STRING + OTHER_STRING);
+    RIFT_VALUE_BENCHMARK("subtract/integer", INTEGER - OTHER_INTEGER);
+    RIFT_VALUE_BENCHMARK("subtract/string", STRING - OTHER_STRING);
+    RIFT_VALUE_BENCHMARK("multiply/integer", INTEGER * OTHER_INTEGER);
+    RIFT_VALUE_BENCHMARK("multiply/string", OTHER_STRING * OTHER_INTEGER);
+    RIFT_VALUE_BENCHMARK("divide/float", INTEGER / FLOAT);
+    RIFT_VALUE_BENCHMARK("modulo/integer", INTEGER % OTHER_INTEGER);
+    RIFT_VALUE_BENCHMARK("power/integer", OTHER_INTEGER ^ rift::Value(3));
+    RIFT_VALUE_BENCHMARK("equal/integer", INTEGER == OTHER_INTEGER);
+    RIFT_VALUE_BENCHMARK("equal/string", STRING == OTHER_STRING);
+    RIFT_VALUE_BENCHMARK("less/float", INTEGER < FLOAT);
+    RIFT_VALUE_BENCHMARK("and/boolean", BOOLEAN && INTEGER);
+    RIFT_VALUE_BENCHMARK("negate/integer", -INTEGER);
+    RIFT_VALUE_BENCHMARK("not/string", !STRING);
+    RIFT_VALUE_BENCHMARK("toString/integer", INTEGER.toString());
+    RIFT_VALUE_BENCHMARK("toString/float", FLOAT.toString());
+    RIFT_VALUE_BENCHMARK("array/iterate", sumArray());
+    RIFT_VALUE_BENCHMARK("array/copy", rift::Array(ARRAY.getArray()));
+
+#undef RIFT_VALUE_BENCHMARK
+
+}
@@ -2,9 +2,12 @@
 #ifndef RIFT_HPP
 #define RIFT_HPP
 
+#include "rift/cache.hpp"
 #include "rift/script.hpp"
 #include "rift/value.hpp"
 #include "rift/config.hpp"
+#include "rift/optimizer.hpp"
+#include "rift/schema.hpp"
 #include "rift/errors/compile.hpp"
 
 #include <Geode/Result.hpp>
@@ -18,16 +21,37 @@ namespace rift {
     /// @brief Compiles a script from a string
     /// @param source the source code to compile
     /// @param directMode whether the script will be used in evaluation mode (no segments)
+    /// @param level how aggressively the parsed tree is simplified, see OptimizationLevel
+    /// @param checkFunctions whether calls to functions that are not registered are reported as a CompileError,
+    /// instead of failing when the call is evaluated
     /// @return a Result containing the compiled script if successful, otherwise a CompileError
-    CompileResult compile(std::string_view source, bool directMode = false) noexcept;
+    CompileResult compile(
+        std::string_view source, bool directMode = false,
+        OptimizationLevel level = OptimizationLevel::Basic, bool checkFunctions = false
+    ) noexcept;
+
+    /// @brief Compiles a script from a string, resolving the variables of the schema to frame slots
+    /// @note Evaluate the script with Script::eval(std::span<Value const>), the Object overloads still work by name.
+    /// @param source the source code to compile
+    /// @param schema the variables that will be passed in the frame
+    /// @param directMode whether the script will be used in evaluation mode (no segments)
+    /// @param level how aggressively the parsed tree is simplified, see OptimizationLevel
+    /// @param checkFunctions whether calls to functions that are not registered are reported as a CompileError
+    /// @return a Result containing the compiled script if successful, otherwise a CompileError
+    CompileResult compile(
+        std::string_view source, VariableSchema const& schema, bool directMode = false,
+        OptimizationLevel level = OptimizationLevel::Basic, bool checkFunctions = false
+    ) noexcept;
 
     /// @brief Formats a script using the given variables
+    /// @note The compiled script is kept in the ScriptCache, so repeated calls with the same source skip parsing.
     /// @param source the source code to format
     /// @param variables the variables to use in the script
     /// @return a Result containing the formatted string if successful, otherwise a CompileError
     FormatResult format(std::string_view source, Object const& variables = {}) noexcept;
 
     /// @brief Evaluates a script using the given variables
+    /// @note The compiled script is kept in the ScriptCache, so repeated calls with the same source skip parsing.
     /// @param source the source code to evaluate
     /// @param variables the variables to use in the script
     /// @return a Result containing the evaluated value if successful, otherwise a CompileError
@@ -0,0 +1,90 @@
+#pragma once
+#ifndef RIFT_ARENA_HPP
+#define RIFT_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace rift {
+
+    /// @brief Bump allocator that owns the nodes of a compiled script.
+    /// Objects are carved out of a few large blocks and released all at once when the arena is destroyed.
+    /// Only objects that are not trivially destructible are tracked, so their destructors can run.
+    class Arena {
+    public:
+        /// @brief Size of the first block, every following block doubles up to MAX_BLOCK_SIZE.
+        static constexpr size_t INITIAL_BLOCK_SIZE = 1024;
+        static constexpr size_t MAX_BLOCK_SIZE = 64 * 1024;
+
+        Arena() noexcept = default;
+        Arena(Arena const&) = delete;
+        Arena& operator=(Arena const&) = delete;
+        Arena(Arena&& other) noexcept;
+        Arena& operator=(Arena&& other) noexcept;
+        ~Arena() noexcept;
+
+        /// @brief Allocate uninitialized memory.
+        /// @param size the number of bytes
+        /// @param alignment the alignment of the memory, must be a power of two
+        /// @return a pointer to the memory, valid for the lifetime of the arena
+        [[nodiscard]] void* allocate(size_t size, size_t alignment) noexcept;
+
+        /// @brief Construct an object in the arena.
+        /// @return a pointer to the object, destroyed together with the arena
+        template <typename T, typename... Args>
+        T* make(Args&&... args) noexcept {
+            auto* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+            if constexpr (!std::is_trivially_destructible_v<T>) {
+                m_destructors.push_back({ [](void* ptr) { static_cast<T*>(ptr)->~T(); }, object });
+            }
+            return object;
+        }
+
+        /// @brief Copy a range of trivially copyable elements into the arena.
+        template <typename T> requires std::is_trivially_copyable_v<T>
+        std::span<T> copy(std::span<T const> items) noexcept {
+            if (items.empty()) return {};
+            auto* data = static_cast<T*>(allocate(items.size_bytes(), alignof(T)));
+            std::uninitialized_copy(items.begin(), items.end(), data);
+            return { data, items.size() };
+        }
+
+        /// @brief Copy a string into the arena.
+        std::string_view copy(std::string_view str) noexcept {
+            if (str.empty()) return {};
+            auto* data = static_cast<char*>(allocate(str.size(), alignof(char)));
+            std::char_traits<char>::copy(data, str.data(), str.size());
+            return { data, str.size() };
+        }
+
+        /// @brief Returns the number of bytes reserved from the system.
+        [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+        /// @brief Returns the number of bytes handed out, including alignment padding.
+        [[nodiscard]] size_t used() const noexcept { return m_used; }
+
+    private:
+        struct Destructor {
+            void (*destroy)(void*);
+            void* object;
+        };
+
+        void reset() noexcept;
+
+        std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+        std::vector<Destructor> m_destructors;
+        std::byte* m_cursor = nullptr;
+        std::byte* m_end = nullptr;
+        size_t m_nextBlockSize = INITIAL_BLOCK_SIZE;
+        size_t m_capacity = 0;
+        size_t m_used = 0;
+    };
+
+}
+
+#endif // RIFT_ARENA_HPP
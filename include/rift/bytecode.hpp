@@ -0,0 +1,136 @@
+#pragma once
+#ifndef RIFT_BYTECODE_HPP
+#define RIFT_BYTECODE_HPP
+
+#include "config.hpp"
+#include "value.hpp"
+#include "schema.hpp"
+#include "errors/runtime.hpp"
+#include "nodes/node.hpp"
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <Geode/Result.hpp>
+
+namespace rift {
+
+    class PathNode;
+
+    enum class OpCode : uint8_t {
+        Constant,      // push constants[a]
+        Load,          // push the variable names[a]
+        LoadSlot,      // push frame[a], or the variable names[b] if the frame is too small
+        Access,        // pop object, push object[names[a]]
+        Index,         // pop key, pop object, push object.at(key)
+        LoadPath,      // push the end of paths[a], starting at the variable names[b]
+
+        Add, Subtract, Multiply, Divide, Modulo, Power,             // pop rhs, pop lhs, push lhs op rhs
+        Equal, NotEqual, Less, Greater, LessEqual, GreaterEqual,    // pop rhs, pop lhs, push lhs op rhs
+        Negate, Not, Truthy, Interpolate,                           // pop value, push op value
+
+        Resolve,       // push the function bound by bindings[a] onto the function stack
+        ResolveDynamic,// pop callee, push the function named by it onto the function stack
+        LazyArgument,  // if the function on top of the function stack takes lazyArguments[a] lazily, push it unevaluated and continue at b
+        Call,          // pop a function and b arguments, push the call result
+
+        Jump,          // continue at a
+        JumpIfFalse,   // pop condition, continue at a if it is falsy
+        JumpIfFalseOrPop, // if the top is falsy, replace it with false and continue at a, pop it otherwise
+        JumpIfTrueOrPop,  // if the top is truthy, replace it with true and continue at a, pop it otherwise
+        Append,        // pop a value and append it to the output
+        AppendConstant,// append constants[a] to the output
+        AppendVariable,// append the variable names[b] to the output without copying it, read from frame[a] if in range
+        AppendPath,    // append the end of paths[a], starting at the variable names[b], to the output without copying it
+        Raise,         // fail with the message constants[a]
+    };
+
+    struct Instruction {
+        OpCode opcode;
+        uint32_t a = 0;
+        uint32_t b = 0;
+    };
+
+    using ChunkResult = geode::Result<Value, RuntimeError>;
+
+    /// @brief A script lowered to a flat instruction stream, executed by a stack machine.
+    /// This is an alternative to walking the tree with the Visitor.
+    class Chunk {
+    public:
+        /// @brief Lower a tree into a chunk.
+        /// The chunk refers to the nodes of call arguments, which are evaluated from the tree if a function takes them lazily,
+        /// and to the steps of path nodes, so the tree has to outlive the chunk.
+        /// @param root the root node of the compiled script
+        /// @return the compiled chunk
+        static Chunk compile(Node const& root) noexcept;
+
+        /// @brief Execute the chunk using the given variables.
+        /// @param variables the variables to use in the script
+        /// @param frame the values of the schema variables, indexed by slot
+        /// @param schema the schema the script was compiled with, if any
+        /// @param precision the number of decimals floats are rendered with
+        /// @return the result of the evaluation, or a RuntimeError
+        [[nodiscard]] ChunkResult run(
+            Object const& variables, std::span<Value const> frame = {}, VariableSchema const* schema = nullptr,
+            int precision = Value::DEFAULT_PRECISION
+        ) const noexcept;
+
+        /// @brief Execute the chunk and write its string result into a buffer.
+        /// Template segments are appended one by one, without building a temporary string.
+        /// @param out the buffer, cleared before writing
+        /// @param variables the variables to use in the script
+        /// @param frame the values of the schema variables, indexed by slot
+        /// @param schema the schema the script was compiled with, if any
+        /// @param precision the number of decimals floats are rendered with
+        /// @return a RuntimeError if the evaluation failed
+        [[nodiscard]] RenderResult runInto(
+            std::string& out, Object const& variables,
+            std::span<Value const> frame = {}, VariableSchema const* schema = nullptr,
+            int precision = Value::DEFAULT_PRECISION
+        ) const noexcept;
+
+        /// @brief Returns a listing of the instructions for debugging.
+        [[nodiscard]] std::string toDebugString() const noexcept;
+
+        [[nodiscard]] std::vector<Instruction> const& code() const noexcept { return m_code; }
+        [[nodiscard]] std::vector<Value> const& constants() const noexcept { return m_constants; }
+
+    private:
+        struct Span {
+            size_t from, to;
+        };
+
+        struct LazyArgument {
+            Node const* node; // evaluated with the Visitor if the function resolves it
+            uint32_t index;   // position of the argument in the call
+        };
+
+        class Compiler;
+
+        /// @brief Slot operand of instructions that read a variable without a schema slot.
+        static constexpr uint32_t NO_SLOT = UINT32_MAX;
+
+        /// @brief Run the instructions, the result is either left in the output or moved into result.
+        RenderResult execute(
+            std::string& out, Value* result, Object const& variables,
+            std::span<Value const> frame, VariableSchema const* schema, int precision
+        ) const noexcept;
+
+        std::vector<Instruction> m_code;
+        std::vector<Span> m_spans;          // source range of the node that emitted each instruction
+        std::vector<Value> m_constants;
+        std::vector<std::string> m_names;   // variable and member names
+        std::vector<size_t> m_nameHashes;   // Object::hash() of each name
+        std::vector<FunctionBinding> m_bindings;
+        std::vector<LazyArgument> m_lazyArguments;
+        std::vector<PathNode const*> m_paths;
+        size_t m_maxStack = 0;
+        size_t m_maxCalls = 0;
+        bool m_rendersOutput = false;       // whether the chunk renders a template into the output instead of a value
+    };
+
+}
+
+#endif // RIFT_BYTECODE_HPP
@@ -0,0 +1,99 @@
+#pragma once
+#ifndef RIFT_CACHE_HPP
+#define RIFT_CACHE_HPP
+
+#include "script.hpp"
+#include "errors/compile.hpp"
+
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include <Geode/Result.hpp>
+
+namespace rift {
+
+    /// @brief Bounded cache of compiled scripts, shared by rift::format and rift::evaluate.
+    /// Entries are keyed by the source hash and compile mode, and evicted in least-recently-used
+    /// order once the accounted size exceeds the capacity.
+    class ScriptCache {
+        ScriptCache() = default;
+        ScriptCache(ScriptCache const&) = delete;
+        ScriptCache(ScriptCache&&) = delete;
+        ScriptCache& operator=(ScriptCache const&) = delete;
+
+    public:
+        using SharedScript = std::shared_ptr<Script const>;
+        using Result = geode::Result<SharedScript, CompileError>;
+
+        /// @brief Default capacity of the cache in bytes.
+        static constexpr size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+        struct Stats {
+            size_t hits = 0;      // lookups that returned an already compiled script
+            size_t misses = 0;    // lookups that had to compile the source
+            size_t evictions = 0; // entries dropped to stay within the capacity
+            size_t entries = 0;   // number of scripts currently cached
+            size_t size = 0;      // accounted size of all cached entries in bytes
+        };
+
+        /// @brief Returns the global cache instance.
+        static ScriptCache& get() noexcept;
+
+        /// @brief Returns the compiled script for the source, compiling and caching it if needed.
+        /// @param source the source code to compile
+        /// @param directMode whether the script will be used in evaluation mode (no segments)
+        /// @return a Result containing the shared compiled script if successful, otherwise a CompileError
+        Result compile(std::string_view source, bool directMode = false) noexcept;
+
+        /// @brief Removes the entry for the given source and mode, if present.
+        /// @return true if an entry was removed
+        bool invalidate(std::string_view source, bool directMode = false) noexcept;
+
+        /// @brief Removes all entries. Scripts still referenced by callers stay alive.
+        void clear() noexcept;
+
+        /// @brief Sets the maximum accounted size of the cache in bytes.
+        /// A capacity of zero disables caching. Shrinking evicts entries immediately.
+        void setCapacity(size_t bytes) noexcept;
+
+        /// @brief Returns the maximum accounted size of the cache in bytes.
+        [[nodiscard]] size_t capacity() const noexcept;
+
+        /// @brief Returns a snapshot of the cache counters.
+        [[nodiscard]] Stats stats() const noexcept;
+
+        /// @brief Resets the hit, miss and eviction counters.
+        void resetStats() noexcept;
+
+    private:
+        struct Entry {
+            size_t hash;
+            bool directMode;
+            std::string source;
+            SharedScript script;
+            size_t size;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        static size_t hashKey(std::string_view source, bool directMode) noexcept;
+
+        EntryList::iterator find(size_t hash, std::string_view source, bool directMode) noexcept;
+        void erase(EntryList::iterator it) noexcept;
+        void evict() noexcept;
+
+    private:
+        mutable std::mutex m_mutex;
+        EntryList m_entries; // most recently used first
+        std::unordered_multimap<size_t, EntryList::iterator> m_index;
+        size_t m_capacity = DEFAULT_CAPACITY;
+        Stats m_stats;
+    };
+
+}
+
+#endif // RIFT_CACHE_HPP
@@ -5,10 +5,13 @@
 #include "value.hpp"
 #include "util.hpp"
 
+#include <atomic>
 #include <span>
 #include <string>
 #include <functional>
+#include <optional>
 #include <unordered_map>
+#include <unordered_set>
 #include <tuple>
 
 #include <fmt/format.h>
@@ -25,8 +28,25 @@ namespace rift {
                             || std::same_as<T, Object>;
 
     using RuntimeFuncResult = geode::Result<Value>;
+    /// @brief A function callable from scripts.
+    /// String arguments may borrow text from the calling script, detach() them before storing them elsewhere.
     using RuntimeFunction = std::function<RuntimeFuncResult(std::span<Value const>)>;
 
+    /// @brief Bit mask of the parameters a function takes unevaluated, bit i stands for parameter i
+    /// and the highest bit also covers every parameter after it.
+    /// Lazy arguments are passed as lazy values, which are only evaluated when the function first resolves or converts them.
+    /// They can only be used during the call, lazy arguments the function returns, even inside a container, are resolved before it ends.
+    using LazyParameters = uint64_t;
+
+    /// @brief Every parameter of the function is lazy.
+    constexpr LazyParameters ALL_LAZY = ~LazyParameters(0);
+
+    /// @brief Returns true if the parameter at the given index is lazy.
+    constexpr bool isLazyParameter(LazyParameters lazy, size_t index) noexcept {
+        constexpr size_t BITS = sizeof(LazyParameters) * 8;
+        return (lazy >> (index < BITS ? index : BITS - 1)) & 1;
+    }
+
     /// @brief Global configuration for the Rift library.
     class Config {
         Config();
@@ -52,20 +72,65 @@ namespace rift {
         /// @param name the name of the function
         /// @param function the function to add, must follow this signature:
         /// <code>geode::Result<Value>(std::span<Value const>)</code>
-        void registerFunction(std::string const& name, RuntimeFunction&& function) noexcept {
+        /// @param pure whether the function always returns the same result for the same arguments
+        /// and has no side effects, which allows calls with constant arguments to be folded at compile time
+        /// @param lazy the parameters that are only evaluated if the function uses them
+        void registerFunction(
+            std::string const& name, RuntimeFunction&& function, bool pure = false, LazyParameters lazy = 0
+        ) noexcept {
             m_functions[name] = std::move(function);
+            setPure(name, pure);
+            setLazy(name, lazy);
+            m_returnTypes.erase(name);
+            m_generation++;
+        }
+
+        /// @brief Declare the type a function always returns, which lets type inference pick specialized operators
+        /// for expressions that use its result. Functions added with makeFunction declare it on their own.
+        /// @param name the name of the function
+        /// @param type the type of the returned values
+        void setReturnType(std::string const& name, Value::Type type) noexcept {
+            m_returnTypes[name] = type;
+        }
+
+        /// @brief Returns the declared return type of a function, if any.
+        /// @param name the name of the function
+        std::optional<Value::Type> returnType(std::string_view name) const noexcept {
+            if (auto it = m_returnTypes.find(name); it != m_returnTypes.end()) {
+                return it->second;
+            }
+            return std::nullopt;
         }
 
         /// @brief Retrieve a function by name.
         /// @param name the name of the function
         /// @return a pointer to the function, or nullptr if not found
-        RuntimeFunction const* getFunction(std::string const& name) const noexcept {
+        RuntimeFunction const* getFunction(std::string_view name) const noexcept {
             if (auto it = m_functions.find(name); it != m_functions.end()) {
                 return &it->second;
             }
             return nullptr;
         }
 
+        /// @brief Returns a counter that changes every time a function is registered or replaced.
+        /// Call sites bound with FunctionBinding use it to know when to look the function up again.
+        uint64_t generation() const noexcept { return m_generation; }
+
+        /// @brief Check whether a function was registered as pure.
+        /// @param name the name of the function
+        bool isPure(std::string_view name) const noexcept {
+            return m_pureFunctions.contains(name);
+        }
+
+        /// @brief Returns the parameters a function takes lazily.
+        /// @param name the name of the function
+        LazyParameters lazyParameters(std::string_view name) const noexcept {
+            if (auto it = m_lazyFunctions.find(name); it != m_lazyFunctions.end()) {
+                return it->second;
+            }
+            return 0;
+        }
+
     private:
         template <size_t I, typename T, typename... Args>
         static geode::Result<std::tuple<T, Args...>> unwrapArgsImpl(std::span<Value const> args) {
@@ -89,6 +154,24 @@ namespace rift {
             return geode::Ok(std::tuple());
         }
 
+        /// @brief Returns the type of the Value a C++ return type converts to, if it is always the same.
+        template <typename T>
+        static constexpr std::optional<Value::Type> typeOf() noexcept {
+            if constexpr (std::same_as<T, bool>) {
+                return Value::Type::Boolean;
+            } else if constexpr (std::same_as<T, int64_t> || std::same_as<T, int>) {
+                return Value::Type::Integer;
+            } else if constexpr (std::same_as<T, double> || std::same_as<T, float>) {
+                return Value::Type::Float;
+            } else if constexpr (std::same_as<T, std::string>) {
+                return Value::Type::String;
+            } else if constexpr (std::same_as<T, void>) {
+                return Value::Type::Null;
+            } else {
+                return std::nullopt;
+            }
+        }
+
         template <typename... Args>
         static geode::Result<std::tuple<Args...>> unwrapArgs(std::span<Value const> args) {
             if constexpr (sizeof...(Args) != 0) {
@@ -108,8 +191,17 @@ namespace rift {
         /// @tparam Args the argument types of the function
         /// @param name the name of the function
         /// @param func the function pointer
+        /// @param pure whether the function has no side effects and can be folded at compile time
         template <typename Ret, typename... Args>
-        void makeFunction(std::string const& name, Ret(*func)(Args...)) noexcept {
+        void makeFunction(std::string const& name, Ret(*func)(Args...), bool pure = false) noexcept {
+            setPure(name, pure);
+            setLazy(name, 0);
+            if (auto type = typeOf<Ret>()) {
+                m_returnTypes[name] = *type;
+            } else {
+                m_returnTypes.erase(name);
+            }
+            m_generation++;
             m_functions[name] = [func](std::span<Value const> args) -> RuntimeFuncResult {
                 // Unwrap the arguments with deduced types
                 auto res = unwrapArgs<Args...>(args);
@@ -134,8 +226,64 @@ namespace rift {
         }
 
     private:
+        void setPure(std::string const& name, bool pure) noexcept {
+            if (pure) {
+                m_pureFunctions.insert(name);
+            } else {
+                m_pureFunctions.erase(name);
+            }
+        }
+
+        void setLazy(std::string const& name, LazyParameters lazy) noexcept {
+            if (lazy) {
+                m_lazyFunctions[name] = lazy;
+            } else {
+                m_lazyFunctions.erase(name);
+            }
+        }
+
         Object m_globals;
-        std::unordered_map<std::string, RuntimeFunction> m_functions;
+        std::unordered_map<std::string, RuntimeFunction, util::StringHash, std::equal_to<>> m_functions;
+        std::unordered_set<std::string, util::StringHash, std::equal_to<>> m_pureFunctions;
+        std::unordered_map<std::string, LazyParameters, util::StringHash, std::equal_to<>> m_lazyFunctions;
+        std::unordered_map<std::string, Value::Type, util::StringHash, std::equal_to<>> m_returnTypes;
+        uint64_t m_generation = 0;
+    };
+
+    /// @brief A call site bound to a function of the global configuration by name.
+    /// The function is looked up once and reused until the configuration generation changes,
+    /// so evaluating a call does not hash the name every time.
+    class FunctionBinding {
+    public:
+        /// @param name the name of the function, must outlive the binding
+        explicit FunctionBinding(std::string_view name) noexcept : m_name(name) {}
+
+        FunctionBinding(FunctionBinding const& other) noexcept
+            : m_name(other.m_name),
+              m_function(other.m_function.load(std::memory_order_relaxed)),
+              m_lazy(other.m_lazy.load(std::memory_order_relaxed)),
+              m_generation(other.m_generation.load(std::memory_order_acquire)) {}
+
+        FunctionBinding& operator=(FunctionBinding const&) = delete;
+
+        /// @brief Returns the bound function, looking it up again if the configuration changed since it was bound.
+        /// @return a pointer to the function, or nullptr if no function with this name is registered
+        RuntimeFunction const* resolve() const noexcept;
+
+        /// @brief Returns the lazy parameters of the function returned by the last resolve().
+        [[nodiscard]] LazyParameters lazyParameters() const noexcept { return m_lazy.load(std::memory_order_relaxed); }
+
+        /// @brief Returns the name of the function.
+        [[nodiscard]] std::string_view name() const noexcept { return m_name; }
+
+    private:
+        static constexpr uint64_t UNBOUND = static_cast<uint64_t>(-1);
+
+        std::string_view m_name;
+        // shared scripts are evaluated from multiple threads, so rebinding has to be race-free
+        mutable std::atomic<RuntimeFunction const*> m_function = nullptr;
+        mutable std::atomic<LazyParameters> m_lazy = 0;
+        mutable std::atomic<uint64_t> m_generation = UNBOUND;
     };
 
 }
@@ -0,0 +1,262 @@
+#pragma once
+#ifndef RIFT_FLATMAP_HPP
+#define RIFT_FLATMAP_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace rift {
+
+    /// @brief Hash map from strings to T that keeps its entries in insertion order.
+    /// Entries are stored contiguously and indexed by an open-addressing table with linear probing,
+    /// lookups take a std::string_view, so no key has to be allocated to find an entry.
+    /// @warning Unlike std::unordered_map, inserting may move existing entries, which invalidates references to them.
+    /// operator[] always leaves room for one more entry, so `map["a"] = map["b"]` stays valid when "a" is new,
+    /// but a reference kept across any other insertion, or across erase(), has to be looked up again.
+    template <typename T>
+    class FlatMap {
+    public:
+        using key_type = std::string;
+        using mapped_type = T;
+        using value_type = std::pair<std::string, T>;
+        using size_type = size_t;
+        using iterator = typename std::vector<value_type>::iterator;
+        using const_iterator = typename std::vector<value_type>::const_iterator;
+
+        FlatMap() noexcept = default;
+        FlatMap(FlatMap const&) = default;
+        FlatMap(FlatMap&&) noexcept = default;
+        FlatMap& operator=(FlatMap const&) = default;
+        FlatMap& operator=(FlatMap&&) noexcept = default;
+
+        /// @brief Build a map from a list of pairs, later duplicates of a key are ignored.
+        FlatMap(std::initializer_list<value_type> items) {
+            reserve(items.size());
+            for (auto const& item : items) {
+                insert(item);
+            }
+        }
+
+        FlatMap& operator=(std::initializer_list<value_type> items) {
+            clear();
+            reserve(items.size());
+            for (auto const& item : items) {
+                insert(item);
+            }
+            return *this;
+        }
+
+        iterator begin() noexcept { return m_entries.begin(); }
+        iterator end() noexcept { return m_entries.end(); }
+        const_iterator begin() const noexcept { return m_entries.begin(); }
+        const_iterator end() const noexcept { return m_entries.end(); }
+        const_iterator cbegin() const noexcept { return m_entries.cbegin(); }
+        const_iterator cend() const noexcept { return m_entries.cend(); }
+
+        [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+
+        /// @brief Make room for at least `count` entries without growing the index.
+        void reserve(size_t count) {
+            m_entries.reserve(count);
+            m_hashes.reserve(count);
+            if (count * 2 > m_slots.size()) {
+                rehash(count * 2);
+            }
+        }
+
+        void clear() noexcept {
+            m_entries.clear();
+            m_hashes.clear();
+            m_slots.clear();
+        }
+
+        iterator find(std::string_view key) noexcept {
+            auto index = indexOf(key, hash(key));
+            return index == NOT_FOUND ? end() : begin() + static_cast<ptrdiff_t>(index);
+        }
+
+        const_iterator find(std::string_view key) const noexcept {
+            auto index = indexOf(key, hash(key));
+            return index == NOT_FOUND ? end() : begin() + static_cast<ptrdiff_t>(index);
+        }
+
+        /// @brief Find a key whose hash was computed ahead of time with hash().
+        /// Names known at compile time are hashed once, so looking them up does not touch the key until a slot matches.
+        iterator find(std::string_view key, size_t keyHash) noexcept {
+            auto index = indexOf(key, keyHash);
+            return index == NOT_FOUND ? end() : begin() + static_cast<ptrdiff_t>(index);
+        }
+
+        const_iterator find(std::string_view key, size_t keyHash) const noexcept {
+            auto index = indexOf(key, keyHash);
+            return index == NOT_FOUND ? end() : begin() + static_cast<ptrdiff_t>(index);
+        }
+
+        [[nodiscard]] bool contains(std::string_view key) const noexcept {
+            return indexOf(key, hash(key)) != NOT_FOUND;
+        }
+
+        [[nodiscard]] size_t count(std::string_view key) const noexcept {
+            return contains(key) ? 1 : 0;
+        }
+
+        /// @throws std::out_of_range if the key is not in the map.
+        T& at(std::string_view key) {
+            auto it = find(key);
+            if (it == end()) throw std::out_of_range("FlatMap::at");
+            return it->second;
+        }
+
+        /// @throws std::out_of_range if the key is not in the map.
+        T const& at(std::string_view key) const {
+            auto it = find(key);
+            if (it == end()) throw std::out_of_range("FlatMap::at");
+            return it->second;
+        }
+
+        /// @brief Returns the value for the key, inserting a default constructed one if it is missing.
+        /// Room for this entry and the next one is made before the reference is taken,
+        /// so the reference survives one more insertion, like the other side of `map["a"] = map["b"]`.
+        T& operator[](std::string_view key) {
+            if (m_entries.capacity() < m_entries.size() + 2) {
+                m_entries.reserve(std::max(m_entries.size() * 2, MIN_SLOTS));
+            }
+            return try_emplace(key).first->second;
+        }
+
+        /// @brief Insert a value constructed from `args` unless the key is already present.
+        template <typename... Args>
+        std::pair<iterator, bool> try_emplace(std::string_view key, Args&&... args) {
+            auto keyHash = hash(key);
+            if (auto index = indexOf(key, keyHash); index != NOT_FOUND) {
+                return { begin() + static_cast<ptrdiff_t>(index), false };
+            }
+
+            m_entries.emplace_back(
+                std::piecewise_construct,
+                std::forward_as_tuple(key),
+                std::forward_as_tuple(std::forward<Args>(args)...)
+            );
+            m_hashes.push_back(keyHash);
+            link(m_entries.size() - 1);
+            return { end() - 1, true };
+        }
+
+        template <typename K, typename... Args>
+        std::pair<iterator, bool> emplace(K&& key, Args&&... args) {
+            return try_emplace(std::string_view(key), std::forward<Args>(args)...);
+        }
+
+        std::pair<iterator, bool> insert(value_type const& item) {
+            return try_emplace(item.first, item.second);
+        }
+
+        std::pair<iterator, bool> insert(value_type&& item) {
+            return try_emplace(item.first, std::move(item.second));
+        }
+
+        template <typename V>
+        std::pair<iterator, bool> insert_or_assign(std::string_view key, V&& value) {
+            auto result = try_emplace(key, std::forward<V>(value));
+            if (!result.second) {
+                result.first->second = std::forward<V>(value);
+            }
+            return result;
+        }
+
+        /// @brief Remove the entry with the given key, keeping the order of the others.
+        /// @note Takes linear time, since the entries after it shift down and the index is rebuilt.
+        /// @return the number of removed entries
+        size_t erase(std::string_view key) {
+            auto index = indexOf(key, hash(key));
+            if (index == NOT_FOUND) return 0;
+
+            m_entries.erase(m_entries.begin() + static_cast<ptrdiff_t>(index));
+            m_hashes.erase(m_hashes.begin() + static_cast<ptrdiff_t>(index));
+            rehash(m_slots.size());
+            return 1;
+        }
+
+        /// @brief Two maps are equal if they have the same entries, in any order.
+        bool operator==(FlatMap const& other) const {
+            if (size() != other.size()) return false;
+            for (size_t i = 0; i < m_entries.size(); ++i) {
+                auto index = other.indexOf(m_entries[i].first, m_hashes[i]);
+                if (index == NOT_FOUND || !(other.m_entries[index].second == m_entries[i].second)) {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        /// @brief Returns the hash the map uses for a key, to be passed to find() later.
+        [[nodiscard]] static size_t hash(std::string_view key) noexcept {
+            return std::hash<std::string_view>{}(key);
+        }
+
+    private:
+        static constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+        static constexpr uint32_t EMPTY_SLOT = 0;
+        static constexpr size_t MIN_SLOTS = 8;
+
+        size_t indexOf(std::string_view key, size_t keyHash) const noexcept {
+            if (m_slots.empty()) return NOT_FOUND;
+
+            auto mask = m_slots.size() - 1;
+            for (auto i = keyHash & mask;; i = (i + 1) & mask) {
+                auto slot = m_slots[i];
+                if (slot == EMPTY_SLOT) return NOT_FOUND;
+                if (m_hashes[slot - 1] == keyHash && m_entries[slot - 1].first == key) return slot - 1;
+            }
+        }
+
+        /// @brief Add an entry to the index, growing it to keep the load factor at or below one half.
+        void link(size_t index) {
+            if (m_entries.size() * 2 > m_slots.size()) {
+                rehash(m_slots.size() * 2);
+                return;
+            }
+
+            auto mask = m_slots.size() - 1;
+            auto i = m_hashes[index] & mask;
+            while (m_slots[i] != EMPTY_SLOT) {
+                i = (i + 1) & mask;
+            }
+            m_slots[i] = static_cast<uint32_t>(index + 1);
+        }
+
+        void rehash(size_t capacity) {
+            size_t slots = MIN_SLOTS;
+            while (slots < capacity) {
+                slots *= 2;
+            }
+
+            m_slots.assign(slots, EMPTY_SLOT);
+            auto mask = slots - 1;
+            for (size_t index = 0; index < m_hashes.size(); ++index) {
+                auto i = m_hashes[index] & mask;
+                while (m_slots[i] != EMPTY_SLOT) {
+                    i = (i + 1) & mask;
+                }
+                m_slots[i] = static_cast<uint32_t>(index + 1);
+            }
+        }
+
+        std::vector<value_type> m_entries;
+        std::vector<size_t> m_hashes; // parallel to m_entries, so growing the index never rehashes a key
+        std::vector<uint32_t> m_slots; // entry index + 1, or EMPTY_SLOT
+    };
+
+}
+
+#endif // RIFT_FLATMAP_HPP
@@ -0,0 +1,42 @@
+#pragma once
+#ifndef RIFT_INFERENCE_HPP
+#define RIFT_INFERENCE_HPP
+
+#include "kernels.hpp"
+#include "schema.hpp"
+#include "token.hpp"
+#include "nodes/node.hpp"
+
+#include <optional>
+
+namespace rift {
+
+    /// @brief Infers the types of expressions at compile time and picks a Kernel for every binary operator
+    /// whose operand types are known.
+    /// Types come from literals, the declared return types of functions and the declared types of schema variables.
+    /// Kernels check the operand types again when they run, so a declaration that turns out wrong only costs the check.
+    class TypeInference {
+    public:
+        /// @param schema the schema the script is compiled with, its declared types are used for slot variables
+        explicit TypeInference(VariableSchema const& schema) noexcept : m_schema(schema) {}
+
+        /// @brief Annotate the binary operators of a tree.
+        /// @param root the root of the tree
+        /// @return the number of operators that got a specialized kernel
+        size_t annotate(Node& root) noexcept;
+
+    private:
+        /// @brief Returns the type every evaluation of the node produces, or nullopt if it can vary.
+        std::optional<Value::Type> infer(Node& node) noexcept;
+
+        static std::optional<Value::Type> binaryType(TokenType op, std::optional<Value::Type> lhs, std::optional<Value::Type> rhs) noexcept;
+        static Kernel pickKernel(TokenType op, std::optional<Value::Type> lhs, std::optional<Value::Type> rhs) noexcept;
+
+    private:
+        VariableSchema const& m_schema;
+        size_t m_annotated = 0;
+    };
+
+}
+
+#endif // RIFT_INFERENCE_HPP
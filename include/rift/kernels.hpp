@@ -0,0 +1,108 @@
+#pragma once
+#ifndef RIFT_KERNELS_HPP
+#define RIFT_KERNELS_HPP
+
+#include "token.hpp"
+#include "value.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace rift {
+
+    /// @brief Specialized implementation of a binary operator, picked at compile time by TypeInference.
+    enum class Kernel : uint8_t {
+        Generic, // the Value operators, which handle every combination of types
+        Integer, // both operands are integers
+        Float,   // both operands are numbers and at least one of them is a float
+        String,  // both operands are strings, only used for equality
+    };
+
+    namespace detail {
+        template <typename T>
+        bool compare(TokenType op, T lhs, T rhs, Value& result) noexcept {
+            switch (op) {
+                case TokenType::EQUAL_EQUAL: result = lhs == rhs; return true;
+                case TokenType::NOT_EQUAL: result = lhs != rhs; return true;
+                case TokenType::LESS: result = lhs < rhs; return true;
+                case TokenType::GREATER: result = lhs > rhs; return true;
+                case TokenType::LESS_EQUAL: result = lhs <= rhs; return true;
+                case TokenType::GREATER_EQUAL: result = lhs >= rhs; return true;
+                default: return false;
+            }
+        }
+    }
+
+    /// @brief Apply a binary operator with a kernel, skipping the type dispatch of the generic operators.
+    /// The operand types are checked first, so a wrong guess at compile time only costs the check.
+    /// Results match the generic operators exactly, including division by zero.
+    /// @param kernel the kernel picked for the operator
+    /// @param op the operator
+    /// @param lhs the left operand
+    /// @param rhs the right operand
+    /// @param result receives the result, may not alias the operands
+    /// @return false if the operands do not fit the kernel and the generic operator has to be used
+    inline bool applyKernel(Kernel kernel, TokenType op, Value const& lhs, Value const& rhs, Value& result) noexcept {
+        switch (kernel) {
+            case Kernel::Integer: {
+                if (!lhs.isInteger() || !rhs.isInteger()) return false;
+                auto a = lhs.getInteger();
+                auto b = rhs.getInteger();
+                switch (op) {
+                    case TokenType::PLUS: result = a + b; return true;
+                    case TokenType::MINUS: result = a - b; return true;
+                    case TokenType::STAR: result = a * b; return true;
+                    case TokenType::SLASH:
+                        if (b == 0) {
+                            result = a < 0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                        } else {
+                            result = a / b;
+                        }
+                        return true;
+                    case TokenType::PERCENT:
+                        result = b == 0 ? Value(std::numeric_limits<double>::quiet_NaN()) : Value(a % b);
+                        return true;
+                    case TokenType::CARET: result = std::pow(a, b); return true;
+                    default: return detail::compare(op, a, b, result);
+                }
+            }
+            case Kernel::Float: {
+                bool numbers = (lhs.isFloat() || lhs.isInteger()) && (rhs.isFloat() || rhs.isInteger());
+                if (!numbers || (!lhs.isFloat() && !rhs.isFloat())) return false;
+                auto a = lhs.isFloat() ? lhs.getFloat() : static_cast<double>(lhs.getInteger());
+                auto b = rhs.isFloat() ? rhs.getFloat() : static_cast<double>(rhs.getInteger());
+                switch (op) {
+                    case TokenType::PLUS: result = a + b; return true;
+                    case TokenType::MINUS: result = a - b; return true;
+                    case TokenType::STAR: result = a * b; return true;
+                    case TokenType::SLASH:
+                        if (b == 0.0) {
+                            result = a < 0.0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+                        } else {
+                            result = a / b;
+                        }
+                        return true;
+                    case TokenType::PERCENT:
+                        result = b == 0.0 ? std::numeric_limits<double>::quiet_NaN() : std::fmod(a, b);
+                        return true;
+                    case TokenType::CARET: result = std::pow(a, b); return true;
+                    default: return detail::compare(op, a, b, result);
+                }
+            }
+            case Kernel::String: {
+                if (!lhs.isString() || !rhs.isString()) return false;
+                switch (op) {
+                    case TokenType::EQUAL_EQUAL: result = lhs.getStringView() == rhs.getStringView(); return true;
+                    case TokenType::NOT_EQUAL: result = lhs.getStringView() != rhs.getStringView(); return true;
+                    default: return false;
+                }
+            }
+            default:
+                return false;
+        }
+    }
+
+}
+
+#endif // RIFT_KERNELS_HPP
@@ -24,6 +24,24 @@ namespace rift {
             return m_index >= m_source.size();
         }
 
+        /// @brief Decode the escape sequences of a token value.
+        /// @param source the raw token value
+        /// @param out buffer of at least source.size() characters, decoding never grows the string
+        /// @return the length of the decoded string
+        static size_t unescape(std::string_view source, char* out) noexcept {
+            size_t size = 0;
+            for (size_t i = 0; i < source.size(); i++) {
+                if (source[i] == '\\') {
+                    if (i + 1 < source.size()) {
+                        out[size++] = escapeChar(source[++i]);
+                    }
+                } else {
+                    out[size++] = source[i];
+                }
+            }
+            return size;
+        }
+
     private:
         LexerResult nextSegment();
         LexerResult nextExpression();
@@ -63,21 +81,6 @@ namespace rift {
             }
         }
 
-        static std::string escapedString(std::string_view source) {
-            std::string result;
-            result.reserve(source.size());
-            for (size_t i = 0; i < source.size(); i++) {
-                if (source[i] == '\\') {
-                    if (i + 1 < source.size()) {
-                        result.push_back(escapeChar(source[++i]));
-                    }
-                } else {
-                    result.push_back(source[i]);
-                }
-            }
-            return result;
-        }
-
         [[nodiscard]] constexpr char peek() const {
             return isEnd() ? '\0' : m_source[m_index];
         }
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef RIFT_NATIVE_HPP
+#define RIFT_NATIVE_HPP
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace rift {
+
+    class Value;
+
+    /// @brief A property of a host object, read when a script accesses it.
+    struct NativeProperty {
+        std::string_view name;
+        Value (*get)(void const* object); // must not throw
+    };
+
+    /// @brief Describes how scripts read a host C++ type, see Value::native().
+    /// Properties are looked up by name on every access, so the values always reflect the live object
+    /// and nothing has to be copied into an Object up front. Types are meant to be defined once, as statics:
+    /// @code
+    /// static constexpr rift::NativeProperty PLAYER_PROPERTIES[] = {
+    ///     {"x", [](void const* p) -> rift::Value { return static_cast<Player const*>(p)->x; }},
+    ///     {"name", [](void const* p) -> rift::Value { return rift::Value::borrowed(static_cast<Player const*>(p)->name); }},
+    /// };
+    /// static rift::NativeType const PLAYER_TYPE("Player", PLAYER_PROPERTIES);
+    ///
+    /// variables["player"] = rift::Value::native(&player, PLAYER_TYPE);
+    /// @endcode
+    class NativeType {
+    public:
+        /// @brief Reads an element by key, for `object[key]` in scripts; must not throw.
+        using Indexer = Value (*)(void const* object, Value const& key);
+
+        /// @brief Maximum number of native types that can exist at once.
+        static constexpr uint32_t MAX_TYPES = 1024;
+
+        /// @param name the name of the type
+        /// @param properties the properties scripts can read, the table has to outlive the type
+        /// @param indexer reads `object[key]`, if not set the key is used as a property name
+        NativeType(std::string_view name, std::span<NativeProperty const> properties, Indexer indexer = nullptr) noexcept;
+        ~NativeType() noexcept;
+
+        NativeType(NativeType const&) = delete;
+        NativeType& operator=(NativeType const&) = delete;
+
+        [[nodiscard]] std::string_view name() const noexcept { return m_name; }
+        [[nodiscard]] std::span<NativeProperty const> properties() const noexcept { return m_properties; }
+
+        /// @brief Find a property by name.
+        /// @return the property, or nullptr if the type does not have it
+        [[nodiscard]] NativeProperty const* property(std::string_view name) const noexcept;
+
+        /// @brief Read a property of an object of this type.
+        /// @return the value of the property, or null if the type does not have it
+        [[nodiscard]] Value get(void const* object, std::string_view name) const noexcept;
+
+        /// @brief Read an element of an object of this type with the indexer, or the property named by the key.
+        [[nodiscard]] Value at(void const* object, Value const& key) const noexcept;
+
+        /// @brief Returns the id values use to refer to this type, 0 if more than MAX_TYPES types were created.
+        [[nodiscard]] uint32_t id() const noexcept { return m_id; }
+
+        /// @brief Returns the type with the given id, or nullptr if it was destroyed.
+        [[nodiscard]] static NativeType const* fromId(uint32_t id) noexcept;
+
+    private:
+        std::string_view m_name;
+        std::span<NativeProperty const> m_properties;
+        Indexer m_indexer;
+        uint32_t m_id;
+    };
+
+}
+
+#endif // RIFT_NATIVE_HPP
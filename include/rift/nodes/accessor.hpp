@@ -4,31 +4,39 @@
 
 #include "node.hpp"
 
-#include <memory>
-#include <string>
+#include <string_view>
 
 namespace rift {
 
     class AccessorNode final : public Node {
     public:
-        explicit AccessorNode(std::unique_ptr<Node> node, std::string name, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_node(std::move(node)), m_name(std::move(name)) { m_type = Type::Accessor; }
+        explicit AccessorNode(Node* node, std::string_view name, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_node(node), m_name(name), m_hash(Object::hash(name)) { m_type = Type::Accessor; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             return fmt::format("AccessorNode({}, {})", m_node->toDebugString(), m_name);
         }
 
-        [[nodiscard]] std::unique_ptr<Node> const& node() const noexcept {
+        [[nodiscard]] Node const* node() const noexcept {
             return m_node;
         }
 
-        [[nodiscard]] std::string const& name() const noexcept {
+        [[nodiscard]] std::string_view name() const noexcept {
             return m_name;
         }
 
+        /// @brief Returns the hash of the member name, computed once when the node is parsed.
+        [[nodiscard]] size_t hash() const noexcept {
+            return m_hash;
+        }
+
     private:
-        std::unique_ptr<Node> m_node;
-        std::string m_name;
+        friend class Optimizer;
+        friend class TypeInference;
+
+        Node* m_node;
+        std::string_view m_name;
+        size_t m_hash;
     };
 
 }
@@ -3,28 +3,36 @@
 #define RIFT_BINARY_NODE_HPP
 
 #include "node.hpp"
+#include "../kernels.hpp"
 #include "../token.hpp"
 
-#include <memory>
 
 namespace rift {
 
     class BinaryNode final : public Node {
     public:
-        explicit BinaryNode(std::unique_ptr<Node> lhs, TokenType op, std::unique_ptr<Node> rhs, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_lhs(std::move(lhs)), m_rhs(std::move(rhs)), m_op(op) { m_type = Type::Binary; }
+        explicit BinaryNode(Node* lhs, TokenType op, Node* rhs, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_lhs(lhs), m_rhs(rhs), m_op(op) { m_type = Type::Binary; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             return fmt::format("BinaryNode({}, {}, {})", m_lhs->toDebugString(), TOKEN_TYPE_NAMES[static_cast<size_t>(m_op)], m_rhs->toDebugString());
         }
 
-        [[nodiscard]] std::unique_ptr<Node> const& lhs() const noexcept { return m_lhs; }
-        [[nodiscard]] std::unique_ptr<Node> const& rhs() const noexcept { return m_rhs; }
+        [[nodiscard]] Node const* lhs() const noexcept { return m_lhs; }
+        [[nodiscard]] Node const* rhs() const noexcept { return m_rhs; }
         [[nodiscard]] TokenType op() const noexcept { return m_op; }
 
+        /// @brief Returns the kernel picked by type inference, Kernel::Generic if the operand types are unknown.
+        [[nodiscard]] Kernel kernel() const noexcept { return m_kernel; }
+
     private:
-        std::unique_ptr<Node> m_lhs, m_rhs;
+        friend class Optimizer;
+        friend class TypeInference;
+
+        Node* m_lhs;
+        Node* m_rhs;
         TokenType m_op;
+        Kernel m_kernel = Kernel::Generic;
     };
 
 }
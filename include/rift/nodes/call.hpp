@@ -3,13 +3,22 @@
 #define RIFT_CALL_NODE_HPP
 
 #include "node.hpp"
+#include "identifier.hpp"
+#include "../config.hpp"
+
+#include <optional>
 
 namespace rift {
 
     class CallNode final : public Node {
     public:
-        explicit CallNode(std::unique_ptr<Node> node, std::vector<std::unique_ptr<Node>> args, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_node(std::move(node)), m_args(std::move(args)) { m_type = Type::Call; }
+        explicit CallNode(Node* node, std::span<Node*> args, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_node(node), m_args(args) {
+            m_type = Type::Call;
+            if (m_node->type() == Type::Identifier) {
+                m_binding.emplace(static_cast<IdentifierNode const&>(*m_node).name());
+            }
+        }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             std::string result = fmt::format("CallNode({}", m_node->toDebugString());
@@ -20,11 +29,11 @@ namespace rift {
             return result + ")";
         }
 
-        [[nodiscard]] std::unique_ptr<Node> const& node() const noexcept {
+        [[nodiscard]] Node const* node() const noexcept {
             return m_node;
         }
 
-        [[nodiscard]] std::vector<std::unique_ptr<Node>> const& args() const noexcept {
+        [[nodiscard]] std::span<Node const* const> args() const noexcept {
             return m_args;
         }
 
@@ -32,9 +41,18 @@ namespace rift {
             return m_args.size();
         }
 
+        /// @brief Returns the binding of a call to a named function, or nullptr if the callee is computed at runtime.
+        [[nodiscard]] FunctionBinding const* binding() const noexcept {
+            return m_binding ? &*m_binding : nullptr;
+        }
+
     private:
-        std::unique_ptr<Node> m_node;
-        std::vector<std::unique_ptr<Node>> m_args;
+        friend class Optimizer;
+        friend class TypeInference;
+
+        Node* m_node;
+        std::span<Node*> m_args;
+        std::optional<FunctionBinding> m_binding;
     };
 
 }
@@ -3,27 +3,40 @@
 #define RIFT_IDENTIFIER_NODE_HPP
 
 #include "node.hpp"
+#include "../schema.hpp"
 
 namespace rift {
 
     class IdentifierNode final : public Node {
     public:
-        explicit IdentifierNode(std::string name, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_name(std::move(name)) { m_type = Type::Identifier; }
-
-        explicit IdentifierNode(Token const& token) noexcept
-            : Node(token.fromIndex, token.toIndex), m_name(token.value) { m_type = Type::Identifier; }
+        explicit IdentifierNode(std::string_view name, size_t fromIndex, size_t toIndex, size_t slot = VariableSchema::NO_SLOT) noexcept
+            : Node(fromIndex, toIndex), m_name(name), m_hash(Object::hash(name)), m_slot(slot) { m_type = Type::Identifier; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
+            if (m_slot != VariableSchema::NO_SLOT) {
+                return fmt::format("IdentifierNode({}, slot={})", m_name, m_slot);
+            }
             return fmt::format("IdentifierNode({})", m_name);
         }
 
-        [[nodiscard]] std::string const& name() const noexcept {
+        [[nodiscard]] std::string_view name() const noexcept {
             return m_name;
         }
 
+        /// @brief Returns the hash of the name, computed once when the node is parsed.
+        [[nodiscard]] size_t hash() const noexcept {
+            return m_hash;
+        }
+
+        /// @brief Returns the frame slot assigned by the VariableSchema, or VariableSchema::NO_SLOT.
+        [[nodiscard]] size_t slot() const noexcept {
+            return m_slot;
+        }
+
     private:
-        std::string m_name;
+        std::string_view m_name;
+        size_t m_hash;
+        size_t m_slot = VariableSchema::NO_SLOT;
     };
 
 }
@@ -13,6 +13,7 @@ namespace rift {
     class Visitor;
 
     using RuntimeResult = geode::Result<Value, RuntimeError>;
+    using RenderResult = geode::Result<void, RuntimeError>;
 
     class Node {
     public:
@@ -31,15 +32,20 @@ namespace rift {
             Call,          // Function call
             Accessor,      // Accessor (for objects)
             Indexer,       // Indexer (for arrays)
+            Path,          // Chain of accessors and constant indexers on a variable
             Value          // Literal value
         };
 
-        virtual ~Node() = default;
-
         /// @brief Returns the type of the node.
         /// @return the type of the node
         [[nodiscard]] Type type() const noexcept { return m_type; }
 
+        /// @brief Returns the index in source where the node starts.
+        [[nodiscard]] size_t fromIndex() const noexcept { return m_fromIndex; }
+
+        /// @brief Returns the index in source where the node ends.
+        [[nodiscard]] size_t toIndex() const noexcept { return m_toIndex; }
+
         /// @brief Construct a RuntimeError with the given message.
         /// @param message the error message
         /// @return a RuntimeError with the given message
@@ -60,6 +66,10 @@ namespace rift {
         }
 
     protected:
+        // nodes are owned by the Arena of their script and never deleted through a base pointer,
+        // keeping the destructor trivial lets the arena skip most of them entirely
+        ~Node() = default;
+
         Type m_type = Type::Segment;
         size_t m_fromIndex, m_toIndex;
     };
@@ -80,6 +90,7 @@ struct fmt::formatter<rift::Node::Type> : formatter<std::string_view> {
             case rift::Node::Type::Call: name = "Call"; break;
             case rift::Node::Type::Accessor: name = "Accessor"; break;
             case rift::Node::Type::Indexer: name = "Indexer"; break;
+            case rift::Node::Type::Path: name = "Path"; break;
             case rift::Node::Type::Value: name = "Value"; break;
         }
         return formatter<std::string_view>::format(name, ctx);
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef RIFT_PATH_NODE_HPP
+#define RIFT_PATH_NODE_HPP
+
+#include "node.hpp"
+#include "identifier.hpp"
+
+#include <span>
+#include <string_view>
+
+namespace rift {
+
+    /// @brief One member access or constant index of a PathNode.
+    struct PathStep {
+        enum class Kind : uint8_t {
+            Member, // .name
+            Index,  // [constant]
+        };
+
+        Kind kind;
+        std::string_view name; // the member name, or the index as a string for looking it up in objects
+        size_t hash = 0;       // Object::hash() of the name
+        int64_t index = 0;     // the index as an integer for looking it up in arrays
+        Value const* key = nullptr; // the index itself, for containers that are neither arrays nor objects
+    };
+
+    /// @brief A chain of member accesses and constant indices on a variable, like `player.position.x` or `items[0].name`.
+    /// The optimizer collapses nested Accessor and Indexer nodes into one of these,
+    /// so the chain is walked in a loop and only its last element is ever copied.
+    class PathNode final : public Node {
+    public:
+        /// @param root the variable the path starts at
+        /// @param steps the accesses applied to it in order, owned by the arena of the script
+        explicit PathNode(IdentifierNode const* root, std::span<PathStep const> steps, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_root(root), m_steps(steps) { m_type = Type::Path; }
+
+        [[nodiscard]] std::string toDebugString() const noexcept override {
+            std::string result = fmt::format("PathNode({}", m_root->toDebugString());
+            for (auto const& step : m_steps) {
+                if (step.kind == PathStep::Kind::Member) {
+                    result += fmt::format(", .{}", step.name);
+                } else {
+                    result += fmt::format(", [{}]", step.key->toString());
+                }
+            }
+            return result + ")";
+        }
+
+        [[nodiscard]] IdentifierNode const& root() const noexcept {
+            return *m_root;
+        }
+
+        [[nodiscard]] std::span<PathStep const> steps() const noexcept {
+            return m_steps;
+        }
+
+    private:
+        IdentifierNode const* m_root;
+        std::span<PathStep const> m_steps;
+    };
+
+}
+
+#endif // RIFT_PATH_NODE_HPP
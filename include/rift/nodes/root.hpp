@@ -4,15 +4,14 @@
 
 #include "node.hpp"
 
-#include <vector>
-#include <memory>
+#include <span>
 
 namespace rift {
 
     class RootNode final : public Node {
     public:
-        explicit RootNode(std::vector<std::unique_ptr<Node>> nodes, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_nodes(std::move(nodes)) { m_type = Type::Root; }
+        explicit RootNode(std::span<Node*> nodes, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_nodes(nodes) { m_type = Type::Root; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             std::string result = "RootNode(";
@@ -23,12 +22,15 @@ namespace rift {
             return result + ")";
         }
 
-        [[nodiscard]] std::vector<std::unique_ptr<Node>> const& nodes() const noexcept {
+        [[nodiscard]] std::span<Node const* const> nodes() const noexcept {
             return m_nodes;
         }
 
     private:
-        std::vector<std::unique_ptr<Node>> m_nodes;
+        friend class Optimizer;
+        friend class TypeInference;
+
+        std::span<Node*> m_nodes;
     };
 
 }
@@ -10,22 +10,19 @@ namespace rift {
 
     class SegmentNode final : public Node {
     public:
-        explicit SegmentNode(std::string value, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_value(std::move(value)) { m_type = Type::Segment; }
-
-        explicit SegmentNode(Token const& token) noexcept
-            : Node(token.fromIndex, token.toIndex), m_value(token.value) { m_type = Type::Segment; }
+        explicit SegmentNode(std::string_view value, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_value(value) { m_type = Type::Segment; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             return fmt::format("SegmentNode(\"{}\")", m_value);
         }
 
-        [[nodiscard]] std::string const& value() const noexcept {
+        [[nodiscard]] std::string_view value() const noexcept {
             return m_value;
         }
 
     private:
-        std::string m_value;
+        std::string_view m_value;
     };
 
 }
@@ -8,13 +8,13 @@ namespace rift {
 
     class TernaryNode final : public Node {
     public:
-        explicit TernaryNode(std::unique_ptr<Node> cond, std::unique_ptr<Node> trueBranch, std::unique_ptr<Node> falseBranch, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_cond(std::move(cond)), m_trueBranch(std::move(trueBranch)), m_falseBranch(std::move(falseBranch)) { m_type = Type::Ternary; }
+        explicit TernaryNode(Node* cond, Node* trueBranch, Node* falseBranch, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_cond(cond), m_trueBranch(trueBranch), m_falseBranch(falseBranch) { m_type = Type::Ternary; }
 
         // constructor for null coalescing operator (??)
         // only has a true branch
-        explicit TernaryNode(std::unique_ptr<Node> cond, std::unique_ptr<Node> trueBranch, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_cond(std::move(cond)), m_trueBranch(std::move(trueBranch)) { m_type = Type::Ternary; }
+        explicit TernaryNode(Node* cond, Node* trueBranch, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_cond(cond), m_trueBranch(trueBranch) { m_type = Type::Ternary; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             return fmt::format(
@@ -42,9 +42,12 @@ namespace rift {
         }
 
     private:
-        std::unique_ptr<Node> m_cond;
-        std::unique_ptr<Node> m_trueBranch;
-        std::unique_ptr<Node> m_falseBranch;
+        friend class Optimizer;
+        friend class TypeInference;
+
+        Node* m_cond;
+        Node* m_trueBranch;
+        Node* m_falseBranch = nullptr;
     };
 
 }
@@ -8,8 +8,8 @@ namespace rift {
 
     class UnaryNode final : public Node {
     public:
-        explicit UnaryNode(TokenType op, std::unique_ptr<Node> value, size_t fromIndex, size_t toIndex) noexcept
-            : Node(fromIndex, toIndex), m_value(std::move(value)), m_op(op) { m_type = Type::Unary; }
+        explicit UnaryNode(TokenType op, Node* value, size_t fromIndex, size_t toIndex) noexcept
+            : Node(fromIndex, toIndex), m_value(value), m_op(op) { m_type = Type::Unary; }
 
         [[nodiscard]] std::string toDebugString() const noexcept override {
             return fmt::format("UnaryNode({}, {})", TOKEN_TYPE_NAMES[static_cast<size_t>(m_op)], m_value->toDebugString());
@@ -24,7 +24,10 @@ namespace rift {
         }
 
     private:
-        std::unique_ptr<Node> m_value;
+        friend class Optimizer;
+        friend class TypeInference;
+
+        Node* m_value;
         TokenType m_op;
     };
 
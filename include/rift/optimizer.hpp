@@ -0,0 +1,53 @@
+#pragma once
+#ifndef RIFT_OPTIMIZER_HPP
+#define RIFT_OPTIMIZER_HPP
+
+#include "arena.hpp"
+#include "nodes/node.hpp"
+
+namespace rift {
+
+    class RootNode;
+    struct PathStep;
+
+    /// @brief How aggressively the tree is simplified after parsing.
+    enum class OptimizationLevel {
+        None,      // keep the tree exactly as parsed
+        Basic,     // fold operators on literals, prune ternaries with literal conditions, merge static segments,
+                   // collapse member accesses and constant indices on a variable into one path
+        Aggressive // also inline global constants and fold calls to pure functions,
+                   // assumes that variables passed at evaluation never shadow globals
+    };
+
+    /// @brief Simplifies a parsed tree by evaluating everything that does not depend on variables.
+    class Optimizer {
+    public:
+        /// @param level how aggressively the tree is simplified
+        /// @param arena the arena that owns the tree, replacement nodes are allocated from it
+        explicit Optimizer(OptimizationLevel level, Arena& arena) noexcept : m_level(level), m_arena(arena) {}
+
+        /// @brief Optimize the tree in place.
+        /// @param root the root of the tree, may be replaced
+        /// @return the number of nodes removed from the tree
+        size_t optimize(Node*& root) noexcept;
+
+    private:
+        void visit(Node*& node) noexcept;
+        void mergeSegments(RootNode& root) noexcept;
+        void fold(Node*& node) noexcept;
+        void extendPath(Node*& node, Node const* target, PathStep step) noexcept;
+        void replace(Node*& node, Node* replacement) noexcept;
+        void hoist(Node*& node, Node* child) noexcept;
+
+        static bool isConstant(Node const* node) noexcept;
+        static size_t countNodes(Node const& node) noexcept;
+
+    private:
+        OptimizationLevel m_level;
+        Arena& m_arena;
+        size_t m_removed = 0;
+    };
+
+}
+
+#endif // RIFT_OPTIMIZER_HPP
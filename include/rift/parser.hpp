@@ -2,41 +2,112 @@
 #ifndef RIFT_PARSER_HPP
 #define RIFT_PARSER_HPP
 
+#include "arena.hpp"
 #include "lexer.hpp"
 #include "nodes/node.hpp"
+#include "schema.hpp"
 #include "errors/compile.hpp"
 
-#include <memory>
-#include <stack>
 #include <string>
 #include <string_view>
+#include <vector>
 
 namespace rift {
 
-    using ParseResult = geode::Result<std::unique_ptr<Node>, CompileError>;
+    using ParseResult = geode::Result<Node*, CompileError>;
 
     class Parser {
     public:
-        explicit Parser(Lexer&& lexer, bool directMode = false) noexcept
-            : m_lexer(std::move(lexer)), m_directMode(directMode) {}
+        /// @brief Maximum number of groups and pending operators an expression may nest.
+        /// Deeper expressions are rejected with a ParseError, this bounds the memory of the parser stacks.
+        static constexpr size_t MAX_DEPTH = 256;
+
+        /// @brief Maximum depth of the tree of a single expression, counting its leaves.
+        /// Left-associative chains like `a + a + ...` or `a.b.b...` never stay open on the parser stacks,
+        /// but the passes that run after parsing recurse once per level, so deeper trees are rejected with a ParseError too.
+        /// Sub-templates evaluated by `$` are parsed separately and limited on their own.
+        static constexpr size_t MAX_TREE_DEPTH = 1024;
+
+        /// @param lexer the lexer to read tokens from, nodes refer to its source so it must outlive the tree
+        /// @param arena the arena that owns the parsed nodes, it must outlive the tree
+        /// @param directMode whether the source is a single expression (no segments)
+        /// @param schema if set, identifiers found in the schema are resolved to frame slots
+        explicit Parser(Lexer&& lexer, Arena& arena, bool directMode = false, VariableSchema const* schema = nullptr) noexcept
+            : m_lexer(std::move(lexer)), m_arena(arena), m_directMode(directMode), m_schema(schema) {}
 
         /// @brief Parse the source code into an AST.
         /// @return a ParseResult containing the AST if successful, otherwise a CompileError
         ParseResult parse() noexcept;
 
     private:
+        /// @brief How tightly an operator binds, operators with a higher precedence are applied first.
+        enum class Precedence : uint8_t {
+            None,
+            Logical,        // && ||, at most one per expression
+            Comparison,     // == != < > <= >=, at most one per operand of a logical operator
+            Additive,       // + -
+            Multiplicative, // * / %
+            Prefix,         // + - !
+            Power,          // ^, right-associative
+            Interpolation,  // $, applies to a single accessor chain
+        };
+
+        /// @brief A parsed operand waiting for its operator.
+        struct Operand {
+            Node* node;
+            size_t start;   // index of its first token, including parentheses around it
+            size_t depth;   // depth of the tree under the node, 1 for atoms
+            bool callable;  // whether an argument list may follow, only directly after an atom
+        };
+
+        /// @brief An operator waiting for its right operand.
+        struct Operator {
+            TokenType type;
+            Precedence precedence;
+            bool prefix;
+            size_t start;   // index of the prefix operator itself, unused for binary operators
+        };
+
+        /// @brief A construct that contains a whole expression, it decides what happens when the expression ends.
+        struct Group {
+            enum class Kind : uint8_t {
+                Expression,  // the expression parseExpression() was called for
+                Parentheses, // ( expression )
+                Index,       // operand [ expression ]
+                Arguments,   // operand ( expression, ... )
+                TrueBranch,  // condition ? expression : ...
+                FalseBranch, // condition ? ... : expression
+                Coalesce,    // condition ?? expression
+            };
+
+            Kind kind;
+            size_t operators; // size of the operator stack when the group was opened
+            size_t operands;  // size of the operand stack when the group was opened
+            size_t start;     // index of the opening token of parentheses
+        };
+
         ParseResult parseRoot() noexcept;
         ParseResult parseExpression() noexcept;
-        ParseResult parseBooleanExpression() noexcept;
-        ParseResult parseComparisonExpression() noexcept;
-        ParseResult parseArithmeticExpression() noexcept;
-        ParseResult parseTerm() noexcept;
-        ParseResult parseFactor() noexcept;
-        ParseResult parseInterpolation() noexcept;
-        ParseResult parseAccessor() noexcept;
-        ParseResult parseCall() noexcept;
         ParseResult parseAtom() noexcept;
 
+        /// @brief Returns the precedence of a binary operator, or None if the token is not one.
+        static Precedence precedenceOf(TokenType type) noexcept;
+
+        /// @brief Apply the operator on top of the stack to its operands.
+        void reduce() noexcept;
+
+        /// @brief Returns the error for expressions that exceed MAX_DEPTH or MAX_TREE_DEPTH.
+        [[nodiscard]] CompileError nestedTooDeep() const noexcept;
+
+        /// @brief Apply every operator of the innermost group.
+        void reduceGroup() noexcept;
+
+        /// @brief Returns the precedence of the operator on top of the stack, or None if the innermost group has none.
+        [[nodiscard]] Precedence pendingPrecedence() const noexcept;
+
+        /// @brief Returns the text of a token, decoding escape sequences into the arena if it has any.
+        std::string_view text(Token const& token) noexcept;
+
         LexerResult advance() noexcept {
             auto res = m_lexer.next();
             if (res.isOk()) {
@@ -47,8 +118,14 @@ namespace rift {
 
     private:
         Lexer m_lexer;
+        Arena& m_arena;
         Token m_currentToken = Token::EOFToken(0);
+        // expressions are parsed without recursion, these hold everything that is still open
+        std::vector<Operand> m_operands;
+        std::vector<Operator> m_operators;
+        std::vector<Group> m_groups;
         bool m_directMode = false;
+        VariableSchema const* m_schema = nullptr;
     };
 }
 
@@ -0,0 +1,85 @@
+#pragma once
+#ifndef RIFT_SCHEMA_HPP
+#define RIFT_SCHEMA_HPP
+
+#include "util.hpp"
+#include "value.hpp"
+
+#include <initializer_list>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace rift {
+
+    /// @brief Maps variable names to dense slot indices.
+    /// Scripts compiled with a schema resolve identifiers to slots up front, so they can be evaluated
+    /// with a <code>std::span<Value const></code> frame where every variable access is an array index.
+    class VariableSchema {
+    public:
+        /// @brief Returned by slot() for names that are not part of the schema.
+        static constexpr size_t NO_SLOT = static_cast<size_t>(-1);
+
+        VariableSchema() = default;
+        VariableSchema(std::initializer_list<std::string_view> names) {
+            for (auto name : names) {
+                add(name);
+            }
+        }
+
+        /// @brief Add a variable to the schema.
+        /// @param name the name of the variable
+        /// @return the slot of the variable, or its existing slot if it was already added
+        size_t add(std::string_view name) {
+            if (auto slot = this->slot(name); slot != NO_SLOT) {
+                return slot;
+            }
+            m_names.emplace_back(name);
+            m_types.emplace_back();
+            m_slots.emplace(m_names.back(), m_names.size() - 1);
+            return m_names.size() - 1;
+        }
+
+        /// @brief Add a variable whose value always has the given type.
+        /// Scripts compiled with the schema use the type to pick specialized operators, a value of another type
+        /// still works, it just takes the generic path.
+        /// @param name the name of the variable
+        /// @param type the type of the values passed for it
+        /// @return the slot of the variable
+        size_t add(std::string_view name, Value::Type type) {
+            auto slot = add(name);
+            m_types[slot] = type;
+            return slot;
+        }
+
+        /// @brief Returns the declared type of a slot, if any.
+        [[nodiscard]] std::optional<Value::Type> type(size_t slot) const noexcept {
+            return slot < m_types.size() ? m_types[slot] : std::nullopt;
+        }
+
+        /// @brief Returns the slot of a variable, or NO_SLOT if it is not part of the schema.
+        [[nodiscard]] size_t slot(std::string_view name) const noexcept {
+            if (auto it = m_slots.find(name); it != m_slots.end()) {
+                return it->second;
+            }
+            return NO_SLOT;
+        }
+
+        /// @brief Returns the number of slots, which is the size a frame should have.
+        [[nodiscard]] size_t size() const noexcept { return m_names.size(); }
+
+        /// @brief Returns the variable names, indexed by slot.
+        [[nodiscard]] std::span<std::string const> names() const noexcept { return m_names; }
+
+    private:
+        std::vector<std::string> m_names;
+        std::vector<std::optional<Value::Type>> m_types; // indexed by slot
+        std::unordered_map<std::string, size_t, util::StringHash, std::equal_to<>> m_slots;
+    };
+
+}
+
+#endif // RIFT_SCHEMA_HPP
@@ -2,9 +2,13 @@
 #ifndef RIFT_SCRIPT_HPP
 #define RIFT_SCRIPT_HPP
 
+#include <algorithm>
 #include <memory>
+#include <span>
 
+#include "arena.hpp"
 #include "errors/runtime.hpp"
+#include "schema.hpp"
 #include "value.hpp"
 #include "nodes/node.hpp"
 
@@ -12,26 +16,110 @@
 
 namespace rift {
 
+    class Chunk;
+
     using RunResult = geode::Result<std::string, RuntimeError>;
     using EvalResult = geode::Result<Value, RuntimeError>;
 
     class Script {
     public:
-        explicit Script(std::unique_ptr<Node> root) noexcept : m_root(std::move(root)) {}
+        /// @brief Strategy used to execute the compiled script.
+        enum class Engine {
+            TreeWalker, // evaluate the tree recursively with the Visitor
+            Bytecode    // lower the tree to a Chunk and run it on the stack machine
+        };
+
+        /// @param arena the arena that owns every node of the tree
+        /// @param root the root node of the tree, allocated from the arena
+        /// @param removedNodes how many nodes the optimizer removed
+        /// @param schema the schema used to resolve identifier slots
+        Script(Arena arena, Node const* root, size_t removedNodes = 0, VariableSchema schema = {}) noexcept;
         Script(Script const&) = delete;
         Script(Script&&) = delete;
+        ~Script() noexcept;
 
         [[nodiscard]] RunResult run(Object const& variables = {}) const noexcept;
         [[nodiscard]] EvalResult eval(Object const& variables = {}) const noexcept;
 
+        /// @brief Run the script with a frame of values, indexed by the slots of the schema it was compiled with.
+        /// @param frame the variable values, slots past the end of the frame are looked up as globals
+        [[nodiscard]] RunResult run(std::span<Value const> frame) const noexcept;
+
+        /// @brief Evaluate the script with a frame of values, indexed by the slots of the schema it was compiled with.
+        /// @param frame the variable values, slots past the end of the frame are looked up as globals
+        [[nodiscard]] EvalResult eval(std::span<Value const> frame) const noexcept;
+
+        /// @brief Render the script into a caller-owned buffer.
+        /// The buffer is cleared first and its capacity is reused, so rendering the same script
+        /// in a loop does not allocate once the buffer has grown large enough.
+        /// @param out the buffer to write into, holds partial output if an error is returned
+        /// @param variables the variables to use in the script
+        [[nodiscard]] RenderResult runInto(std::string& out, Object const& variables = {}) const noexcept;
+
+        /// @brief Render the script into a caller-owned buffer, with a frame of values indexed by schema slots.
+        /// @param out the buffer to write into, holds partial output if an error is returned
+        /// @param frame the variable values, slots past the end of the frame are looked up as globals
+        [[nodiscard]] RenderResult runInto(std::string& out, std::span<Value const> frame) const noexcept;
+
+        /// @brief Returns the schema the script was compiled with.
+        [[nodiscard]] VariableSchema const& schema() const noexcept {
+            return m_schema;
+        }
+
+        /// @brief Returns a frame with one null value per slot of the schema, meant to be filled and reused.
+        [[nodiscard]] std::vector<Value> makeFrame() const noexcept {
+            return std::vector<Value>(m_schema.size());
+        }
+
+        /// @brief Select the engine used by run() and eval().
+        /// Switching to the bytecode engine lowers the tree once, up front.
+        void setEngine(Engine engine) noexcept;
+
+        /// @brief Returns the engine used by run() and eval().
+        [[nodiscard]] Engine engine() const noexcept {
+            return m_chunk ? Engine::Bytecode : Engine::TreeWalker;
+        }
+
+        /// @brief Set the number of decimals floats are rendered with, 2 by default.
+        /// Only affects how values are written to the output, converting a float to a string inside an
+        /// expression (like `'x' + 1.5` or `str(1.5)`) always uses Value::DEFAULT_PRECISION.
+        void setPrecision(int precision) noexcept {
+            m_precision = std::max(precision, 0);
+        }
+
+        /// @brief Returns the number of decimals floats are rendered with.
+        [[nodiscard]] int precision() const noexcept {
+            return m_precision;
+        }
+
+        /// @brief Returns how many nodes the optimizer removed while compiling the script.
+        [[nodiscard]] size_t removedNodes() const noexcept {
+            return m_removedNodes;
+        }
+
+        /// @brief Returns the root node of the compiled tree.
+        [[nodiscard]] Node const& root() const noexcept {
+            return *m_root;
+        }
+
+        /// @brief Returns the arena that owns the compiled tree.
+        [[nodiscard]] Arena const& arena() const noexcept {
+            return m_arena;
+        }
+
         [[nodiscard]] std::string toDebugString() const noexcept {
             return m_root->toDebugString();
         }
 
     private:
-        std::unique_ptr<Node> m_root;
+        Arena m_arena;
+        Node const* m_root;
+        std::unique_ptr<Chunk> m_chunk;
+        VariableSchema m_schema;
+        size_t m_removedNodes;
+        int m_precision = Value::DEFAULT_PRECISION;
     };
 
 }
 
-#endif // RIFT_SCRIPT_HPP
\ No newline at end of file
+#endif // RIFT_SCRIPT_HPP
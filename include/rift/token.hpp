@@ -55,29 +55,21 @@ namespace rift {
 
     struct Token {
         TokenType type;
-        std::string value;
+        std::string_view value; // slice of the source, escape sequences are left as written
         size_t fromIndex, toIndex;
+        bool escaped = false;   // whether value contains escape sequences, see Lexer::unescape
 
         constexpr Token(TokenType type, size_t index, size_t toIndex)
             : type(type), fromIndex(index), toIndex(toIndex) {}
 
-        constexpr Token(TokenType type, std::string value, size_t fromIndex, size_t toIndex)
-            : type(type), value(std::move(value)), fromIndex(fromIndex), toIndex(toIndex) {}
-
-        constexpr Token(TokenType type, std::string value, size_t index)
-            : Token(type, std::move(value), index, index + value.size()) {}
-
-        constexpr Token(TokenType type, std::string value)
-            : Token(type, std::move(value), 0, value.size()) {}
-
-        constexpr Token(TokenType type, std::string_view value, size_t fromIndex, size_t toIndex)
-            : Token(type, std::string(value), fromIndex, toIndex) {}
+        constexpr Token(TokenType type, std::string_view value, size_t fromIndex, size_t toIndex, bool escaped = false)
+            : type(type), value(value), fromIndex(fromIndex), toIndex(toIndex), escaped(escaped) {}
 
         constexpr Token(TokenType type, std::string_view value, size_t index)
-            : Token(type, std::string(value), index, index + value.size()) {}
+            : Token(type, value, index, index + value.size()) {}
 
         constexpr Token(TokenType type, std::string_view value)
-            : Token(type, std::string(value), 0, value.size()) {}
+            : Token(type, value, 0, value.size()) {}
 
         constexpr Token(TokenType type, size_t index)
             : Token(type, index, index + 1) {}
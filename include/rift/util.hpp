@@ -4,55 +4,158 @@
 
 #include <Geode/Result.hpp>
 #include <charconv>
+#include <concepts>
+#include <cstdint>
 #include <string>
 #include <string_view>
 #include <utility>
 #include <functional>
+#include <system_error>
+
+#if !defined(__cpp_lib_to_chars)
+#include <locale>
+#include <sstream>
+#endif
 
 namespace rift::util {
 
     template <typename T>
     concept Number = std::is_integral_v<T> || std::is_floating_point_v<T>;
 
+    namespace detail {
+        /// @brief Exact powers of ten, every one of them is representable as a double.
+        constexpr double EXACT_POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        /// @brief Parse anything the fast path in fromChars can not handle exactly.
+        template <std::floating_point Num>
+        std::from_chars_result slowFromChars(char const* first, char const* last, Num& value) noexcept {
+#if defined(__cpp_lib_to_chars)
+            return std::from_chars(first, last, value);
+#else
+            // the classic locale keeps this independent of the global C locale, unlike strtod
+            std::istringstream stream(std::string(first, last));
+            stream.imbue(std::locale::classic());
+            Num result;
+            stream >> result;
+            if (stream.fail()) {
+                return { first, std::errc::invalid_argument };
+            }
+            value = result;
+            auto consumed = stream.eof() ? last - first : static_cast<ptrdiff_t>(stream.tellg());
+            return { first + consumed, std::errc() };
+#endif
+        }
+    }
+
+    /// @brief Parse the number at the start of a string, like std::from_chars.
+    /// Never allocates and never looks at the C locale, so it is safe to call from any thread.
+    /// Accepts an optional minus sign and digits, floating point types also take a fraction and an exponent.
+    /// Decimals with at most 19 significant digits and a small exponent are computed exactly without
+    /// calling into the standard library, which covers the numbers found in scripts and host variables.
+    /// @param str the string to read, parsing stops at the first character that is not part of the number
+    /// @param value set to the parsed number on success, left alone otherwise
+    template <Number Num>
+    std::from_chars_result fromChars(std::string_view str, Num& value) noexcept {
+        auto const* first = str.data();
+        auto const* last = str.data() + str.size();
+        if constexpr (std::is_integral_v<Num>) {
+            return std::from_chars(first, last, value);
+        } else if constexpr (!std::is_same_v<Num, double> && !std::is_same_v<Num, float>) {
+            return detail::slowFromChars(first, last, value);
+        } else {
+            auto const* it = first;
+            bool negative = it != last && *it == '-';
+            if (negative) ++it;
+
+            // gather up to 19 significant digits, which always fit in 64 bits
+            uint64_t mantissa = 0;
+            int digits = 0, exponent = 0;
+            bool anyDigits = false, truncated = false;
+            for (; it != last && *it >= '0' && *it <= '9'; ++it) {
+                anyDigits = true;
+                if (digits < 19) {
+                    mantissa = mantissa * 10 + static_cast<uint64_t>(*it - '0');
+                    if (mantissa != 0) digits++;
+                } else {
+                    truncated = truncated || *it != '0';
+                    exponent++;
+                }
+            }
+            if (it != last && *it == '.') {
+                auto const* fraction = ++it;
+                for (; it != last && *it >= '0' && *it <= '9'; ++it) {
+                    if (digits < 19) {
+                        mantissa = mantissa * 10 + static_cast<uint64_t>(*it - '0');
+                        if (mantissa != 0) digits++;
+                        exponent--;
+                    } else {
+                        truncated = truncated || *it != '0';
+                    }
+                }
+                anyDigits = anyDigits || it != fraction;
+            }
+
+            // infinities, NaNs and anything else unusual
+            if (!anyDigits) {
+                return detail::slowFromChars(first, last, value);
+            }
+
+            if (it != last && (*it == 'e' || *it == 'E')) {
+                auto const* exponentStart = it + 1;
+                bool negativeExponent = exponentStart != last && *exponentStart == '-';
+                if (exponentStart != last && (*exponentStart == '-' || *exponentStart == '+')) ++exponentStart;
+
+                // a dangling 'e' is not part of the number
+                if (exponentStart != last && *exponentStart >= '0' && *exponentStart <= '9') {
+                    int explicitExponent = 0;
+                    for (it = exponentStart; it != last && *it >= '0' && *it <= '9'; ++it) {
+                        if (explicitExponent < 100000) explicitExponent = explicitExponent * 10 + (*it - '0');
+                    }
+                    exponent += negativeExponent ? -explicitExponent : explicitExponent;
+                }
+            }
+
+            // both the mantissa and the power of ten are exact doubles, so a single operation rounds correctly
+            if (!truncated && mantissa <= (uint64_t(1) << 53) && exponent >= -22 && exponent <= 22) {
+                auto result = static_cast<double>(mantissa);
+                result = exponent < 0
+                    ? result / detail::EXACT_POWERS_OF_TEN[-exponent]
+                    : result * detail::EXACT_POWERS_OF_TEN[exponent];
+                value = static_cast<Num>(negative ? -result : result);
+                return { it, std::errc() };
+            }
+
+            return detail::slowFromChars(first, last, value);
+        }
+    }
+
     /// @brief Read a number from a string.
-    /// @note This code is taken from the
+    /// Trailing characters after the number are ignored, see fromChars for the accepted format.
+    /// @note This code is based on the
     /// <a href="https://github.com/geode-sdk/geode/blob/fd2a457e76a2d4ef6958ea83d0d5a006ac1e2dfc/loader/include/Geode/utils/general.hpp#L128">
     /// Geode SDK `numFromString` function.
     /// </a>
     template <Number Num>
     geode::Result<Num> readNumber(std::string_view const str) {
-        if constexpr (std::is_floating_point_v<Num>
-            #if defined(__cpp_lib_to_chars)
-                && false
-            #endif
-        ) {
-            Num val;
-            char* strEnd;
-            errno = 0;
-            if (std::setlocale(LC_NUMERIC, "C")) {
-                if constexpr (std::is_same_v<Num, float>) val = std::strtof(str.data(), &strEnd);
-                else if constexpr (std::is_same_v<Num, double>) val = std::strtod(str.data(), &strEnd);
-                else if constexpr (std::is_same_v<Num, long double>) val = std::strtold(str.data(), &strEnd);
-                if (errno == ERANGE) return geode::Err("Number is too large to fit");
-                if (strEnd == str.data()) return geode::Err("String is not a number");
-                return geode::Ok(val);
-            }
-            return geode::Err("Failed to set locale");
-        } else {
-            Num result;
-            std::from_chars_result res;
-            if constexpr (std::is_floating_point_v<Num>) res = std::from_chars(str.data(), str.data() + str.size(), result);
-            else res = std::from_chars(str.data(), str.data() + str.size(), result);
-
-            auto [ptr, ec] = res;
-            if (ec == std::errc()) return geode::Ok(result);
-            if (ptr != str.data() + str.size()) return geode::Err("String contains trailing extra data");
-            if (ec == std::errc::invalid_argument) return geode::Err("String is not a number");
-            if (ec == std::errc::result_out_of_range) return geode::Err("Number is too large to fit");
-            return geode::Err("Unknown error");
-        }
+        Num result;
+        auto [ptr, ec] = fromChars(str, result);
+        if (ec == std::errc()) return geode::Ok(result);
+        if (ec == std::errc::invalid_argument) return geode::Err("String is not a number");
+        if (ec == std::errc::result_out_of_range) return geode::Err("Number is too large to fit");
+        return geode::Err("Unknown error");
     }
 
+    /// @brief Transparent string hash, allows looking up std::string keys with a std::string_view.
+    struct StringHash {
+        using is_transparent = void;
+        size_t operator()(std::string_view str) const noexcept {
+            return std::hash<std::string_view>{}(str);
+        }
+    };
+
     template <typename T>
         constexpr bool isStringType() {
         using type = std::remove_cvref_t<T>;
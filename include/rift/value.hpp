@@ -2,76 +2,183 @@
 #ifndef RIFT_VALUE_HPP
 #define RIFT_VALUE_HPP
 
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <forward_list>
+#include <functional>
+#include <limits>
 #include <string>
+#include <string_view>
 #include <variant>
 #include <vector>
-#include <unordered_map>
 
 #include <Geode/Result.hpp>
 
+#include "flatmap.hpp"
+#include "native.hpp"
+#include "util.hpp"
+
 namespace rift {
 
     class Value;
 
+    namespace detail {
+        class LazyCache;
+    }
+
     using Array = std::vector<Value>;
-    using Object = std::unordered_map<std::string, Value>;
+    /// @brief Members of an object in insertion order.
+    /// @warning Inserting a member may move the others, so references to members do not survive insertions
+    /// like they did when this was a std::unordered_map. See FlatMap for the one case that is kept working.
+    using Object = FlatMap<Value>;
+
+    namespace detail {
+        /// @brief Heap block shared between copies of a Value.
+        struct RefCounted {
+            std::atomic<uint32_t> refs = 1;
+        };
+
+        template <typename T>
+        struct Shared : RefCounted {
+            template <typename... Args>
+            explicit Shared(Args&&... args) : value(std::forward<Args>(args)...) {}
+
+            T value;
+        };
+    }
 
     /// @brief A value in the AST.
+    /// Numbers, booleans and strings up to 14 bytes are stored inline, longer strings and containers live
+    /// in a reference counted block that is shared between copies, so a Value always fits in 16 bytes.
     class [[nodiscard]] Value {
     public:
-        enum class Type {
+        enum class Type : uint8_t {
             Null,
             String,
             Integer,
             Float,
             Boolean,
             Array,
-            Object
+            Object,
+            Native,
+            Lazy
         };
 
-        constexpr Value() noexcept = default;
-        constexpr Value(Value const&) noexcept = default;
-        constexpr Value(Value&&) noexcept = default;
+        /// @brief Computes the value of a lazy variable, see lazy(); must not throw.
+        using Provider = std::function<Value()>;
+
+        Value() noexcept = default;
+
+        Value(Value const& other) noexcept : m_format(other.m_format), m_type(other.m_type) {
+            std::memcpy(m_payload, other.m_payload, PAYLOAD_SIZE);
+            if (isShared()) {
+                load<detail::RefCounted*>()->refs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+
+        Value(Value&& other) noexcept : m_format(other.m_format), m_type(other.m_type) {
+            std::memcpy(m_payload, other.m_payload, PAYLOAD_SIZE);
+            other.m_type = Type::Null;
+        }
 
-        explicit(false) constexpr Value(std::string value) noexcept
-            : m_type(Type::String), m_data(std::move(value)) {}
-        explicit(false) constexpr Value(std::string_view value) noexcept
-            : m_type(Type::String), m_data(std::string(value)) {}
-        explicit(false) constexpr Value(char const* value) noexcept
-            : m_type(Type::String), m_data(std::string(value)) {}
+        ~Value() noexcept {
+            if (isShared()) release();
+        }
 
-        explicit(false) constexpr Value(int64_t value) noexcept
-            : m_type(Type::Integer), m_data(value) {}
-        explicit(false) constexpr Value(int value) noexcept
-            : m_type(Type::Integer), m_data(value) {}
+        explicit(false) Value(std::string value) noexcept : m_type(Type::String) {
+            if (value.size() <= PAYLOAD_SIZE) {
+                setSmallString(value);
+            } else {
+                setSharedString(new detail::Shared<std::string>(std::move(value)));
+            }
+        }
+        explicit(false) Value(std::string_view value) noexcept : m_type(Type::String) {
+            if (value.size() <= PAYLOAD_SIZE) {
+                setSmallString(value);
+            } else {
+                setSharedString(new detail::Shared<std::string>(value));
+            }
+        }
+        explicit(false) Value(char const* value) noexcept
+            : Value(std::string_view(value)) {}
 
-        explicit(false) constexpr Value(double value) noexcept
-            : m_type(Type::Float), m_data(value) {}
-        explicit(false) constexpr Value(float value) noexcept
-            : m_type(Type::Float), m_data(value) {}
+        explicit(false) Value(int64_t value) noexcept
+            : m_type(Type::Integer) { store(value); }
+        explicit(false) Value(int value) noexcept
+            : m_type(Type::Integer) { store<int64_t>(value); }
 
-        explicit(false) constexpr Value(bool value) noexcept
-            : m_type(Type::Boolean), m_data(value) {}
+        explicit(false) Value(double value) noexcept
+            : m_type(Type::Float) { store(value); }
+        explicit(false) Value(float value) noexcept
+            : m_type(Type::Float) { store<double>(value); }
 
-        explicit(false) constexpr Value(Array value) noexcept
-            : m_type(Type::Array), m_data(std::move(value)) {}
+        explicit(false) Value(bool value) noexcept
+            : m_type(Type::Boolean) { store(value); }
+
+        explicit(false) Value(Array value) noexcept
+            : m_type(Type::Array) { store<detail::RefCounted*>(new detail::Shared<Array>(std::move(value))); }
 
         explicit(false) Value(Object value) noexcept
-            : m_type(Type::Object), m_data(std::move(value)) {}
+            : m_type(Type::Object) { store<detail::RefCounted*>(new detail::Shared<Object>(std::move(value))); }
 
         template <typename T>
-        static constexpr Value from(T&& value) noexcept {
+        static Value from(T&& value) noexcept {
             return Value(std::forward<T>(value));
         }
 
-        static constexpr Value null() noexcept { return {}; }
-        static constexpr Value string(std::string value) noexcept { return {std::move(value)}; }
-        static constexpr Value integer(int64_t value) noexcept { return {value}; }
-        static constexpr Value floating(double value) noexcept { return {value}; }
-        static constexpr Value boolean(bool value) noexcept { return {value}; }
-        static constexpr Value array(Array value) noexcept { return {std::move(value)}; }
+        static Value null() noexcept { return {}; }
+        static Value string(std::string value) noexcept { return {std::move(value)}; }
+        static Value integer(int64_t value) noexcept { return {value}; }
+        static Value floating(double value) noexcept { return {value}; }
+        static Value boolean(bool value) noexcept { return {value}; }
+        static Value array(Array value) noexcept { return {std::move(value)}; }
         static Value object(Object value) noexcept { return {std::move(value)}; }
 
+        /// @brief Create a string value that refers to text owned by someone else, without copying it.
+        /// The text has to outlive the value, scripts use this for the static text stored in their arena.
+        /// @param value the text to refer to
+        static Value borrowed(std::string_view value) noexcept {
+            if (value.size() > std::numeric_limits<uint32_t>::max()) {
+                return {value};
+            }
+
+            Value result;
+            result.m_type = Type::String;
+            result.m_format = BORROWED_STRING;
+            result.store(value.data());
+            result.store(static_cast<uint32_t>(value.size()), sizeof(char const*));
+            return result;
+        }
+
+        /// @brief Create a handle to a host object, whose properties are read from the live object when accessed.
+        /// Nothing is copied, so the object has to outlive the value, including copies kept by scripts.
+        /// @param object the object to refer to
+        /// @param type describes the properties of the object
+        /// @return the handle, or null if the type could not be registered, see NativeType::MAX_TYPES
+        static Value native(void const* object, NativeType const& type) noexcept {
+            Value result;
+            if (type.id() == 0) {
+                return result;
+            }
+
+            result.m_type = Type::Native;
+            result.store(object);
+            result.store(type.id(), sizeof(void const*));
+            return result;
+        }
+
+        /// @brief Create a value that is computed only when a script refers to it.
+        /// Identifiers call the provider on their first use in an evaluation and reuse the result for the rest of it,
+        /// so expensive variables cost nothing in templates that do not mention them.
+        /// @param provider computes the value, called from the thread that evaluates the script
+        static Value lazy(Provider provider) noexcept {
+            Value result;
+            result.m_type = Type::Lazy;
+            result.store<detail::RefCounted*>(new detail::Shared<Provider>(std::move(provider)));
+            return result;
+        }
+
         /// @brief Returns true if the value is null.
         constexpr bool isNull() const noexcept { return m_type == Type::Null; }
 
@@ -93,35 +200,104 @@ namespace rift {
         /// @brief Returns true if the value is an object.
         constexpr bool isObject() const noexcept { return m_type == Type::Object; }
 
+        /// @brief Returns true if the value is a handle to a host object.
+        constexpr bool isNative() const noexcept { return m_type == Type::Native; }
+
+        /// @brief Returns true if the value is computed on demand, see lazy().
+        constexpr bool isLazy() const noexcept { return m_type == Type::Lazy; }
+
+        /// @brief Returns true if the value is a string that refers to text it does not own.
+        constexpr bool isBorrowed() const noexcept { return m_type == Type::String && m_format == BORROWED_STRING; }
+
+        /// @brief Replace borrowed strings with owned copies, including the ones nested in arrays and objects.
+        /// Call this before keeping a value past the lifetime of the script that produced it.
+        void detach() noexcept;
+
         /// @brief Returns the type of the value.
         constexpr Type type() const noexcept { return m_type; }
 
+        /// @brief Reads the value as a string, owned or borrowed, without copying it.
+        /// The view is valid until the value is modified or destroyed, and is not null-terminated.
+        /// @throws std::bad_variant_access if the value is not a string.
+        std::string_view getStringView() const {
+            expect(Type::String);
+            switch (m_format) {
+                case SHARED_STRING:
+                    return static_cast<detail::Shared<std::string> const*>(load<detail::RefCounted*>())->value;
+                case BORROWED_STRING:
+                    return {load<char const*>(), load<uint32_t>(sizeof(char const*))};
+                default:
+                    return {m_payload, m_format};
+            }
+        }
+
         /// @brief Reads the value as a string.
+        /// @note This used to return `std::string const&`. Strings may now be stored inline or borrowed from a script,
+        /// so there is no std::string to refer to and this returns a copy instead. Use getStringView() to read without copying.
         /// @throws std::bad_variant_access if the value is not a string.
-        constexpr const std::string& getString() const { return std::get<std::string>(m_data); }
+        [[deprecated("returns a copy now, use getStringView()")]]
+        std::string getString() const { return std::string(getStringView()); }
 
         /// @brief Reads the value as an integer.
         /// @throws std::bad_variant_access if the value is not an integer.
-        constexpr int64_t getInteger() const { return std::get<int64_t>(m_data); }
+        int64_t getInteger() const { expect(Type::Integer); return load<int64_t>(); }
 
         /// @brief Reads the value as a float.
         /// @throws std::bad_variant_access if the value is not a float.
-        constexpr double getFloat() const { return std::get<double>(m_data); }
+        double getFloat() const { expect(Type::Float); return load<double>(); }
 
         /// @brief Reads the value as a boolean.
         /// @throws std::bad_variant_access if the value is not a boolean.
-        constexpr bool getBoolean() const { return std::get<bool>(m_data); }
+        bool getBoolean() const { expect(Type::Boolean); return load<bool>(); }
 
         /// @brief Reads the value as an array.
         /// @throws std::bad_variant_access if the value is not an array.
-        constexpr const Array& getArray() const { return std::get<Array>(m_data); }
+        /// Copies of a value share the same array, so reading it never copies the elements.
+        const Array& getArray() const {
+            expect(Type::Array);
+            return static_cast<detail::Shared<Array> const*>(load<detail::RefCounted*>())->value;
+        }
 
         /// @brief Reads the value as an object.
         /// @throws std::bad_variant_access if the value is not an object.
-        constexpr const Object& getObject() const { return std::get<Object>(m_data); }
+        const Object& getObject() const {
+            expect(Type::Object);
+            return static_cast<detail::Shared<Object> const*>(load<detail::RefCounted*>())->value;
+        }
+
+        /// @brief Reads the host object a native handle refers to.
+        /// @throws std::bad_variant_access if the value is not a native handle.
+        void const* getNative() const { expect(Type::Native); return load<void const*>(); }
+
+        /// @brief Reads the type of a native handle, nullptr if the type was destroyed since.
+        /// @throws std::bad_variant_access if the value is not a native handle.
+        NativeType const* getNativeType() const {
+            expect(Type::Native);
+            return NativeType::fromId(load<uint32_t>(sizeof(void const*)));
+        }
+
+        /// @brief Computes a lazy value, any other value is returned as is.
+        /// Conversions and operators resolve lazy values themselves, but every call runs the provider again.
+        Value resolve() const noexcept {
+            if (!isLazy()) return *this;
+            return static_cast<detail::Shared<Provider> const*>(load<detail::RefCounted*>())->value();
+        }
+
+        /// @brief Replace lazy values with their results, including the ones nested in arrays and objects.
+        void resolveAll() noexcept;
+
+        /// @brief Number of decimals floats are printed with, unless a script asks for another precision.
+        static constexpr int DEFAULT_PRECISION = 2;
 
         /// @brief Cast the value to a string.
-        std::string toString() const noexcept;
+        /// @param precision the number of decimals to print floats with
+        std::string toString(int precision = DEFAULT_PRECISION) const noexcept;
+
+        /// @brief Append the string representation of the value to a buffer.
+        /// Same output as toString(), numbers are written straight into the buffer without allocating.
+        /// @param out the buffer to append to
+        /// @param precision the number of decimals to print floats with
+        void appendTo(std::string& out, int precision = DEFAULT_PRECISION) const noexcept;
 
         /// @brief Cast the value to an integer.
         int64_t toInteger() const noexcept;
@@ -180,9 +356,16 @@ namespace rift {
 
         // Math operators
 
-        Result operator+(const Value& other) const noexcept;
-        Result operator-(const Value& other) const noexcept;
-        Result operator*(const Value& other) const noexcept;
+        Result operator+(const Value& other) const& noexcept;
+        Result operator-(const Value& other) const& noexcept;
+        Result operator*(const Value& other) const& noexcept;
+
+        // A temporary on the left is modified in place when it owns its string or array,
+        // so chains like `a + b + c` keep appending to the same buffer.
+
+        Result operator+(const Value& other) && noexcept;
+        Result operator-(const Value& other) && noexcept;
+        Result operator*(const Value& other) && noexcept;
         Result operator/(const Value& other) const noexcept;
         Result operator%(const Value& other) const noexcept;
         Result operator^(const Value& other) const noexcept;
@@ -209,11 +392,13 @@ namespace rift {
         Value operator->*(const Value& key) const noexcept;
 
         // Object/Array access operators
+        // Keys used to be taken as `std::string const&`. Strings, literals and char pointers still convert to string_view,
+        // but types that only convert to std::string now need an explicit conversion.
 
         Value operator[](size_t index) const noexcept;
         Value& operator[](size_t index) noexcept;
-        Value operator[](std::string const& key) const noexcept;
-        Value& operator[](std::string const& key) noexcept;
+        Value operator[](std::string_view key) const noexcept;
+        Value& operator[](std::string_view key) noexcept;
 
         // Cast operators
 
@@ -222,12 +407,133 @@ namespace rift {
         explicit operator double() const noexcept { return toFloat(); }
         explicit operator std::string() const noexcept { return toString(); }
 
-        constexpr Value& operator=(Value const&) noexcept = default;
+        Value& operator=(Value const& other) noexcept {
+            if (this != &other) {
+                *this = Value(other);
+            }
+            return *this;
+        }
+
+        Value& operator=(Value&& other) noexcept {
+            if (this != &other) {
+                if (isShared()) release();
+                std::memcpy(m_payload, other.m_payload, PAYLOAD_SIZE);
+                m_format = other.m_format;
+                m_type = other.m_type;
+                other.m_type = Type::Null;
+            }
+            return *this;
+        }
 
     private:
+        friend class detail::LazyCache;
+
+        static constexpr size_t PAYLOAD_SIZE = 14;
+
+        // m_format of a string, anything up to PAYLOAD_SIZE is the length of an inline string
+        static constexpr uint8_t SHARED_STRING = 0xFE;
+        static constexpr uint8_t BORROWED_STRING = 0xFF;
+
+        // a native handle is the object pointer followed by the id of its type
+        static constexpr size_t NATIVE_SIZE = sizeof(void const*) + sizeof(uint32_t);
+        static_assert(NATIVE_SIZE <= PAYLOAD_SIZE);
+
+        template <typename T>
+        T load(size_t offset = 0) const noexcept {
+            static_assert(std::is_trivially_copyable_v<T>);
+            T value;
+            std::memcpy(&value, m_payload + offset, sizeof(T));
+            return value;
+        }
+
+        template <typename T>
+        void store(T value, size_t offset = 0) noexcept {
+            static_assert(std::is_trivially_copyable_v<T>);
+            std::memcpy(m_payload + offset, &value, sizeof(T));
+        }
+
+        void setSmallString(std::string_view value) noexcept {
+            std::memcpy(m_payload, value.data(), value.size());
+            m_format = static_cast<uint8_t>(value.size());
+        }
+
+        void setSharedString(detail::Shared<std::string>* value) noexcept {
+            store<detail::RefCounted*>(value);
+            m_format = SHARED_STRING;
+        }
+
+        void expect(Type type) const {
+            if (m_type != type) throw std::bad_variant_access();
+        }
+
+        /// @brief Returns true if the payload is a reference counted block.
+        constexpr bool isShared() const noexcept {
+            return m_type == Type::Array || m_type == Type::Object || m_type == Type::Lazy
+                || (m_type == Type::String && m_format == SHARED_STRING);
+        }
+
+        /// @brief Returns true if the value is an object or a native handle, which scripts can only read members of.
+        constexpr bool hasMembers() const noexcept { return m_type == Type::Object || m_type == Type::Native; }
+
+        /// @brief Returns the number of properties of a native handle, so it converts to numbers like an object.
+        size_t nativeSize() const noexcept {
+            auto const* type = NativeType::fromId(load<uint32_t>(sizeof(void const*)));
+            return type ? type->properties().size() : 0;
+        }
+
+        /// @brief Drop this value's reference to its shared block, freeing it if it was the last one.
+        void release() noexcept;
+
+        /// @brief Returns the string for writing if this value is its only owner, nullptr otherwise.
+        std::string* uniqueString() noexcept {
+            if (m_type != Type::String || m_format != SHARED_STRING) return nullptr;
+            auto* shared = static_cast<detail::Shared<std::string>*>(load<detail::RefCounted*>());
+            return shared->refs.load(std::memory_order_acquire) == 1 ? &shared->value : nullptr;
+        }
+
+        /// @brief Get the array for writing, cloning it first if other values still share it.
+        Array& mutableArray() noexcept;
+
+        /// @brief Get the object for writing, cloning it first if other values still share it.
+        Object& mutableObject() noexcept;
+
+        /// @brief Returns true if the value contains a borrowed string, see detach().
+        bool hasBorrowed() const noexcept;
+
+        /// @brief Returns true if the value is or contains a lazy value, see resolveAll().
+        bool hasLazy() const noexcept;
+
+        alignas(8) char m_payload[PAYLOAD_SIZE] {};
+        uint8_t m_format = 0;
         Type m_type = Type::Null;
-        std::variant<std::monostate, std::string, int64_t, double, bool, Array, Object> m_data;
     };
+
+    static_assert(sizeof(Value) <= 16, "Value should stay small enough to pass around in two registers");
+
+    namespace detail {
+        /// @brief Results of the lazy values used during one evaluation, both variables and members of containers.
+        /// Entries are keyed by the provider, which copies of a lazy value share, and keep a copy of the lazy value
+        /// so the provider cannot be freed and its address reused while the evaluation runs.
+        class LazyCache {
+        public:
+            /// @brief Returns the value itself, or the memoized result if it is lazy.
+            Value const& resolve(Value const& value) noexcept {
+                if (!value.isLazy()) return value;
+
+                auto const* provider = value.load<RefCounted*>();
+                for (auto const& [source, result] : m_values) {
+                    if (source.load<RefCounted*>() == provider) return result;
+                }
+
+                // a list keeps earlier results in place while the engines still point at them
+                m_values.emplace_front(value, value.resolve());
+                return m_values.front().second;
+            }
+
+        private:
+            std::forward_list<std::pair<Value, Value>> m_values;
+        };
+    }
 }
 
 #endif // RIFT_VALUE_HPP
\ No newline at end of file
@@ -8,18 +8,42 @@
 #include "nodes/call.hpp"
 #include "nodes/identifier.hpp"
 #include "nodes/indexer.hpp"
+#include "nodes/path.hpp"
 #include "nodes/root.hpp"
 #include "nodes/ternary.hpp"
 #include "nodes/unary.hpp"
+#include "schema.hpp"
+
+#include <span>
 
 namespace rift {
 
     using VisitorResult = geode::Result<Value, RuntimeError>;
+    using ReferenceResult = geode::Result<Value const*, RuntimeError>;
 
     class Visitor {
     public:
+        /// @brief Maximum number of nested `$` interpolations before evaluation is aborted.
+        static constexpr size_t MAX_INTERPOLATION_DEPTH = 32;
+
         explicit Visitor(Object const& variables) noexcept : m_variables(variables) {}
 
+        /// @brief Constructs a visitor that reads identifiers with a slot from a frame.
+        /// @param variables the variables used for identifiers without a slot
+        /// @param frame the values of the schema variables, indexed by slot
+        /// @param schema the schema used to resolve names in sub-templates, which are compiled without slots
+        /// @param precision the number of decimals floats are rendered with
+        /// @param lazyValues results of lazy variables to share with the caller, the visitor keeps its own if not set
+        Visitor(
+            Object const& variables, std::span<Value const> frame, VariableSchema const* schema,
+            int precision = Value::DEFAULT_PRECISION, detail::LazyCache* lazyValues = nullptr
+        ) noexcept : m_variables(variables), m_frame(frame), m_schema(schema), m_precision(precision),
+                     m_lazyValues(lazyValues ? lazyValues : &m_ownLazyValues) {}
+
+        // the visitor may point at its own lazy cache
+        Visitor(Visitor const&) = delete;
+        Visitor& operator=(Visitor const&) = delete;
+
         /// @brief Visit a node and evaluate its value.
         /// @param node the node to visit
         /// @return the result of the evaluation as a VisitorResult containing the value or an error
@@ -65,8 +89,63 @@ namespace rift {
         /// @return the result of the evaluation as a VisitorResult containing the value
         [[nodiscard]] VisitorResult visit(IndexerNode const& node) const noexcept;
 
+        /// @brief Visit a path node and evaluate its value.
+        /// @param node the path node to visit
+        /// @return the result of the evaluation as a VisitorResult containing the value
+        [[nodiscard]] VisitorResult visit(PathNode const& node) const noexcept;
+
+        /// @brief Walk the steps of a path starting at the value of its variable.
+        /// Steps never fail, a missing member or an index out of range makes the rest of the path null.
+        /// @param path the path to walk
+        /// @param root the value of the variable the path starts at
+        /// @param temporary storage for values that do not exist anywhere else, like properties of native objects
+        /// @param lazyValues resolves lazy members and elements met along the path
+        /// @return a pointer to the value at the end of the path, valid as long as `root`, `temporary` and `lazyValues` are
+        [[nodiscard]] static Value const* follow(PathNode const& path, Value const& root, Value& temporary, detail::LazyCache& lazyValues) noexcept;
+
+        /// @brief Evaluate a node without copying the value it refers to.
+        /// Identifier, accessor, indexer and path chains point straight into the variables, the frame or the globals,
+        /// any other node is evaluated into `temporary` and a pointer to it is returned.
+        /// @param node the node to evaluate
+        /// @param temporary storage for values that do not exist anywhere else
+        /// @return a pointer to the value, valid as long as the variables and `temporary` are
+        [[nodiscard]] ReferenceResult reference(Node const& node, Value& temporary) const noexcept;
+
+        /// @brief Evaluate a node and append its string representation to a buffer.
+        /// Root nodes write each segment and value straight into the buffer, without building temporaries.
+        /// @param node the node to render
+        /// @param out the buffer to append to
+        /// @return an error if the evaluation failed, the buffer may contain partial output then
+        [[nodiscard]] RenderResult render(Node const& node, std::string& out) const noexcept;
+
+        /// @brief Compile (or fetch from cache) and render the given string as a sub-template.
+        /// This implements the `$` operator.
+        /// @param source the sub-template source
+        /// @return the rendered string, or an error message if compiling or rendering failed
+        [[nodiscard]] geode::Result<Value> interpolate(std::string const& source) const noexcept;
+
+    private:
+        /// @brief Returns the value an identifier refers to, or a null value if it is not defined.
+        /// Lazy variables are computed on their first use and the result is reused for the rest of the evaluation.
+        [[nodiscard]] Value const& lookup(IdentifierNode const& node) const noexcept;
+
+        /// @brief Returns the variable an identifier refers to, without resolving lazy values.
+        [[nodiscard]] Value const& find(IdentifierNode const& node) const noexcept;
+
+        /// @brief Constructs a visitor for a sub-template produced by the `$` operator.
+        Visitor(Visitor const& parent, std::string_view source) noexcept
+            : m_variables(parent.m_variables), m_frame(parent.m_frame), m_schema(parent.m_schema),
+              m_precision(parent.m_precision), m_lazyValues(parent.m_lazyValues), m_parent(&parent), m_source(source) {}
+
     private:
         std::reference_wrapper<Object const> m_variables;
+        std::span<Value const> m_frame;
+        VariableSchema const* m_schema = nullptr;
+        int m_precision = Value::DEFAULT_PRECISION;
+        mutable detail::LazyCache m_ownLazyValues;
+        detail::LazyCache* m_lazyValues = &m_ownLazyValues; // shared with sub-templates
+        Visitor const* m_parent = nullptr; // enclosing visitor, if this one renders a sub-template
+        std::string_view m_source;          // source of the sub-template being rendered
     };
 
 }
@@ -0,0 +1,63 @@
+#include <rift/arena.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace rift {
+
+    Arena::Arena(Arena&& other) noexcept
+        : m_blocks(std::move(other.m_blocks)), m_destructors(std::move(other.m_destructors)),
+          m_cursor(std::exchange(other.m_cursor, nullptr)), m_end(std::exchange(other.m_end, nullptr)),
+          m_nextBlockSize(std::exchange(other.m_nextBlockSize, INITIAL_BLOCK_SIZE)),
+          m_capacity(std::exchange(other.m_capacity, 0)), m_used(std::exchange(other.m_used, 0)) {}
+
+    Arena& Arena::operator=(Arena&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_blocks = std::move(other.m_blocks);
+            m_destructors = std::move(other.m_destructors);
+            m_cursor = std::exchange(other.m_cursor, nullptr);
+            m_end = std::exchange(other.m_end, nullptr);
+            m_nextBlockSize = std::exchange(other.m_nextBlockSize, INITIAL_BLOCK_SIZE);
+            m_capacity = std::exchange(other.m_capacity, 0);
+            m_used = std::exchange(other.m_used, 0);
+        }
+        return *this;
+    }
+
+    Arena::~Arena() noexcept {
+        reset();
+    }
+
+    void Arena::reset() noexcept {
+        // destroy in reverse order of construction, like a stack of locals
+        for (auto it = m_destructors.rbegin(); it != m_destructors.rend(); ++it) {
+            it->destroy(it->object);
+        }
+        m_destructors.clear();
+        m_blocks.clear();
+        m_cursor = m_end = nullptr;
+    }
+
+    void* Arena::allocate(size_t size, size_t alignment) noexcept {
+        auto current = reinterpret_cast<uintptr_t>(m_cursor);
+        auto aligned = (current + alignment - 1) & ~(alignment - 1);
+        if (m_cursor && aligned + size <= reinterpret_cast<uintptr_t>(m_end)) {
+            m_used += aligned + size - current;
+            m_cursor = reinterpret_cast<std::byte*>(aligned + size);
+            return reinterpret_cast<void*>(aligned);
+        }
+
+        // start a new block, large requests get a block of their own size
+        size_t blockSize = std::max(m_nextBlockSize, size + alignment);
+        m_nextBlockSize = std::min(m_nextBlockSize * 2, MAX_BLOCK_SIZE);
+        m_blocks.push_back(std::make_unique_for_overwrite<std::byte[]>(blockSize));
+        m_capacity += blockSize;
+
+        m_cursor = m_blocks.back().get();
+        m_end = m_cursor + blockSize;
+        return allocate(size, alignment);
+    }
+
+}
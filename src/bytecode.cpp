@@ -0,0 +1,684 @@
+#include <rift/bytecode.hpp>
+#include <rift/visitor.hpp>
+
+#include <rift/nodes/segment.hpp>
+#include <rift/nodes/value.hpp>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace rift {
+
+    class Chunk::Compiler {
+    public:
+        explicit Compiler(Chunk& chunk) noexcept : m_chunk(chunk) {}
+
+        void compile(Node const& node) noexcept {
+            switch (node.type()) {
+                case Node::Type::Segment: {
+                    emit(OpCode::Constant, node, constant(Value::borrowed(static_cast<SegmentNode const&>(node).value())));
+                    push();
+                } break;
+                case Node::Type::Value: {
+                    emit(OpCode::Constant, node, constant(borrow(static_cast<ValueNode const&>(node).value())));
+                    push();
+                } break;
+                case Node::Type::Root:
+                    // only the top level of a template is a root, it writes straight into the output
+                    for (auto const* child : static_cast<RootNode const&>(node).nodes()) {
+                        compileOutput(*child);
+                    }
+                    m_chunk.m_rendersOutput = true;
+                    break;
+                case Node::Type::Identifier: {
+                    auto const& identifier = static_cast<IdentifierNode const&>(node);
+                    if (identifier.slot() != VariableSchema::NO_SLOT) {
+                        emit(OpCode::LoadSlot, node, static_cast<uint32_t>(identifier.slot()), name(identifier.name()));
+                    } else {
+                        emit(OpCode::Load, node, name(identifier.name()));
+                    }
+                    push();
+                } break;
+                case Node::Type::Binary:
+                    compileBinary(static_cast<BinaryNode const&>(node));
+                    break;
+                case Node::Type::Unary:
+                    compileUnary(static_cast<UnaryNode const&>(node));
+                    break;
+                case Node::Type::Ternary:
+                    compileTernary(static_cast<TernaryNode const&>(node));
+                    break;
+                case Node::Type::Call:
+                    compileCall(static_cast<CallNode const&>(node));
+                    break;
+                case Node::Type::Accessor: {
+                    auto const& accessor = static_cast<AccessorNode const&>(node);
+                    compile(*accessor.node());
+                    emit(OpCode::Access, node, name(accessor.name()));
+                } break;
+                case Node::Type::Path: {
+                    auto const& path = static_cast<PathNode const&>(node);
+                    emit(OpCode::LoadPath, node, this->path(path), name(path.root().name()));
+                    push();
+                } break;
+                case Node::Type::Indexer: {
+                    auto const& indexer = static_cast<IndexerNode const&>(node);
+                    compile(*indexer.node());
+                    compile(*indexer.index());
+                    emit(OpCode::Index, node);
+                    pop();
+                } break;
+                default: {
+                    emit(OpCode::Raise, node, constant(fmt::format("RuntimeError: Unknown node type '{}'", node.type())));
+                    push();
+                } break;
+            }
+        }
+
+        void finish() noexcept {
+            m_chunk.m_maxStack = m_maxDepth;
+            m_chunk.m_maxCalls = m_maxCalls;
+        }
+
+    private:
+        void compileBinary(BinaryNode const& node) noexcept {
+            if (node.op() == TokenType::AND || node.op() == TokenType::OR) {
+                compileLogical(node);
+                return;
+            }
+
+            compile(*node.lhs());
+            compile(*node.rhs());
+            pop();
+
+            // the kernel picked by type inference travels in the operand
+            auto kernel = static_cast<uint32_t>(node.kernel());
+            switch (node.op()) {
+                case TokenType::PLUS: emit(OpCode::Add, node, kernel); break;
+                case TokenType::MINUS: emit(OpCode::Subtract, node, kernel); break;
+                case TokenType::STAR: emit(OpCode::Multiply, node, kernel); break;
+                case TokenType::SLASH: emit(OpCode::Divide, node, kernel); break;
+                case TokenType::PERCENT: emit(OpCode::Modulo, node, kernel); break;
+                case TokenType::CARET: emit(OpCode::Power, node, kernel); break;
+                case TokenType::EQUAL_EQUAL: emit(OpCode::Equal, node, kernel); break;
+                case TokenType::NOT_EQUAL: emit(OpCode::NotEqual, node, kernel); break;
+                case TokenType::LESS: emit(OpCode::Less, node, kernel); break;
+                case TokenType::GREATER: emit(OpCode::Greater, node, kernel); break;
+                case TokenType::LESS_EQUAL: emit(OpCode::LessEqual, node, kernel); break;
+                case TokenType::GREATER_EQUAL: emit(OpCode::GreaterEqual, node, kernel); break;
+                default: emit(OpCode::Raise, node, constant("RuntimeError: Unknown binary operator")); break;
+            }
+        }
+
+        /// @brief The right side only runs if the left side does not decide the result.
+        void compileLogical(BinaryNode const& node) noexcept {
+            compile(*node.lhs());
+            auto jumpToEnd = emit(node.op() == TokenType::AND ? OpCode::JumpIfFalseOrPop : OpCode::JumpIfTrueOrPop, node);
+            pop();
+
+            compile(*node.rhs());
+            emit(OpCode::Truthy, node);
+            m_chunk.m_code[jumpToEnd].a = static_cast<uint32_t>(m_chunk.m_code.size());
+        }
+
+        void compileUnary(UnaryNode const& node) noexcept {
+            compile(node.value());
+            switch (node.op()) {
+                case TokenType::PLUS: break;
+                case TokenType::MINUS: emit(OpCode::Negate, node); break;
+                case TokenType::NOT: emit(OpCode::Not, node); break;
+                case TokenType::DOLLAR: emit(OpCode::Interpolate, node); break;
+                default: emit(OpCode::Raise, node, constant("RuntimeError: Unknown unary operator")); break;
+            }
+        }
+
+        void compileTernary(TernaryNode const& node) noexcept {
+            compile(node.cond());
+            auto jumpToFalse = emit(OpCode::JumpIfFalse, node);
+            pop();
+
+            compile(node.trueBranch());
+            auto jumpToEnd = emit(OpCode::Jump, node);
+            pop();
+
+            m_chunk.m_code[jumpToFalse].a = static_cast<uint32_t>(m_chunk.m_code.size());
+            if (node.hasFalseBranch()) {
+                compile(node.falseBranch());
+            } else {
+                emit(OpCode::Constant, node, constant(""));
+                push();
+            }
+            m_chunk.m_code[jumpToEnd].a = static_cast<uint32_t>(m_chunk.m_code.size());
+        }
+
+        void compileOutput(Node const& node) noexcept {
+            switch (node.type()) {
+                case Node::Type::Segment:
+                    emit(OpCode::AppendConstant, node, constant(Value::borrowed(static_cast<SegmentNode const&>(node).value())));
+                    break;
+                case Node::Type::Value:
+                    emit(OpCode::AppendConstant, node, constant(borrow(static_cast<ValueNode const&>(node).value())));
+                    break;
+                case Node::Type::Identifier: {
+                    auto const& identifier = static_cast<IdentifierNode const&>(node);
+                    auto slot = identifier.slot() == VariableSchema::NO_SLOT ? NO_SLOT : static_cast<uint32_t>(identifier.slot());
+                    emit(OpCode::AppendVariable, node, slot, name(identifier.name()));
+                } break;
+                case Node::Type::Path: {
+                    auto const& path = static_cast<PathNode const&>(node);
+                    emit(OpCode::AppendPath, node, this->path(path), name(path.root().name()));
+                } break;
+                default:
+                    compile(node);
+                    emit(OpCode::Append, node);
+                    pop();
+                    break;
+            }
+        }
+
+        void compileCall(CallNode const& node) noexcept {
+            // the function is resolved before the arguments are evaluated, same as in the Visitor
+            if (auto const* binding = node.binding()) {
+                m_chunk.m_bindings.push_back(*binding);
+                emit(OpCode::Resolve, node, static_cast<uint32_t>(m_chunk.m_bindings.size() - 1));
+            } else {
+                compile(*node.node());
+                emit(OpCode::ResolveDynamic, node);
+                pop();
+            }
+
+            // whether an argument is lazy depends on the function the call resolves to at runtime
+            m_maxCalls = std::max(m_maxCalls, ++m_calls);
+            for (size_t i = 0; i < node.numArgs(); ++i) {
+                auto const* arg = node.args()[i];
+                m_chunk.m_lazyArguments.push_back(LazyArgument { arg, static_cast<uint32_t>(i) });
+                auto skip = emit(OpCode::LazyArgument, *arg, static_cast<uint32_t>(m_chunk.m_lazyArguments.size() - 1));
+                compile(*arg);
+                m_chunk.m_code[skip].b = static_cast<uint32_t>(m_chunk.m_code.size());
+            }
+            m_calls--;
+
+            emit(OpCode::Call, node, 0, static_cast<uint32_t>(node.numArgs()));
+            pop(node.numArgs());
+            push();
+        }
+
+        size_t emit(OpCode opcode, Node const& node, uint32_t a = 0, uint32_t b = 0) noexcept {
+            m_chunk.m_code.push_back(Instruction { opcode, a, b });
+            m_chunk.m_spans.push_back(Span { node.fromIndex(), node.toIndex() });
+            return m_chunk.m_code.size() - 1;
+        }
+
+        /// @brief String constants refer to the text stored in the tree, so pushing them does not copy it.
+        static Value borrow(Value const& value) noexcept {
+            return value.isString() ? Value::borrowed(value.getStringView()) : value;
+        }
+
+        uint32_t constant(Value value) noexcept {
+            m_chunk.m_constants.push_back(std::move(value));
+            return static_cast<uint32_t>(m_chunk.m_constants.size() - 1);
+        }
+
+        uint32_t name(std::string_view name) noexcept {
+            auto& names = m_chunk.m_names;
+            for (size_t i = 0; i < names.size(); ++i) {
+                if (names[i] == name) {
+                    return static_cast<uint32_t>(i);
+                }
+            }
+            names.emplace_back(name);
+            m_chunk.m_nameHashes.push_back(Object::hash(name));
+            return static_cast<uint32_t>(names.size() - 1);
+        }
+
+        uint32_t path(PathNode const& path) noexcept {
+            m_chunk.m_paths.push_back(&path);
+            return static_cast<uint32_t>(m_chunk.m_paths.size() - 1);
+        }
+
+        void push(size_t count = 1) noexcept {
+            m_depth += count;
+            m_maxDepth = std::max(m_maxDepth, m_depth);
+        }
+
+        void pop(size_t count = 1) noexcept {
+            m_depth -= count;
+        }
+
+    private:
+        Chunk& m_chunk;
+        size_t m_depth = 0;
+        size_t m_maxDepth = 0;
+        size_t m_calls = 0;
+        size_t m_maxCalls = 0;
+    };
+
+    Chunk Chunk::compile(Node const& root) noexcept {
+        Chunk chunk;
+        Compiler compiler(chunk);
+        compiler.compile(root);
+        compiler.finish();
+        return chunk;
+    }
+
+    namespace {
+        /// @brief Stacks of a running chunk, kept per thread so steady-state runs do not allocate.
+        struct Callee {
+            RuntimeFunction const* function;
+            LazyParameters lazy;
+        };
+
+        struct Stacks {
+            std::vector<Value> values;
+            std::vector<Callee> functions;
+        };
+
+        /// @brief Borrows a set of stacks for the current thread.
+        /// Host functions can run nested scripts, so every nesting level gets a set of its own.
+        class StackLease {
+        public:
+            StackLease() noexcept {
+                if (s_depth == s_pool.size()) {
+                    s_pool.push_back(std::make_unique<Stacks>());
+                }
+                m_stacks = s_pool[s_depth++].get();
+            }
+
+            ~StackLease() noexcept {
+                // keep the capacity around for the next run, but release the values right away
+                m_stacks->values.clear();
+                m_stacks->functions.clear();
+                s_depth--;
+            }
+
+            StackLease(StackLease const&) = delete;
+            StackLease& operator=(StackLease const&) = delete;
+
+            Stacks& operator*() const noexcept { return *m_stacks; }
+
+        private:
+            Stacks* m_stacks;
+
+            static thread_local std::vector<std::unique_ptr<Stacks>> s_pool;
+            static thread_local size_t s_depth;
+        };
+
+        thread_local std::vector<std::unique_ptr<Stacks>> StackLease::s_pool;
+        thread_local size_t StackLease::s_depth = 0;
+    }
+
+    ChunkResult Chunk::run(
+        Object const& variables, std::span<Value const> frame, VariableSchema const* schema, int precision
+    ) const noexcept {
+        std::string out;
+        Value result;
+        auto res = execute(out, m_rendersOutput ? nullptr : &result, variables, frame, schema, precision);
+        if (res.isErr()) {
+            return geode::Err(std::move(res.unwrapErr()));
+        }
+        if (m_rendersOutput) {
+            return geode::Ok(Value(std::move(out)));
+        }
+        return geode::Ok(std::move(result));
+    }
+
+    RenderResult Chunk::runInto(
+        std::string& out, Object const& variables, std::span<Value const> frame, VariableSchema const* schema,
+        int precision
+    ) const noexcept {
+        out.clear();
+        if (m_rendersOutput) {
+            return execute(out, nullptr, variables, frame, schema, precision);
+        }
+
+        Value result;
+        auto res = execute(out, &result, variables, frame, schema, precision);
+        if (res.isErr()) {
+            return res;
+        }
+        result.appendTo(out, precision);
+        return geode::Ok();
+    }
+
+    RenderResult Chunk::execute(
+        std::string& out, Value* result, Object const& variables,
+        std::span<Value const> frame, VariableSchema const* schema, int precision
+    ) const noexcept {
+        StackLease lease;
+        auto& stack = (*lease).values;
+        stack.reserve(m_maxStack);
+        auto& functions = (*lease).functions;
+        functions.reserve(m_maxCalls);
+
+        auto error = [this](size_t ip, std::string message) -> RenderResult {
+            return geode::Err(RuntimeError(std::move(message), m_spans[ip].from, m_spans[ip].to));
+        };
+
+        // variables are only copied when they are pushed onto the stack, never when they are appended
+        // names are hashed once when the chunk is compiled, lookups only compare the keys whose hashes match
+        auto find = [&](uint32_t nameIndex, uint32_t slot) -> Value const& {
+            static Value const null;
+            if (slot < frame.size()) {
+                return frame[slot];
+            }
+            auto const& name = m_names[nameIndex];
+            auto hash = m_nameHashes[nameIndex];
+            if (auto it = variables.find(name, hash); it != variables.end()) {
+                return it->second;
+            }
+            if (schema) {
+                if (auto index = schema->slot(name); index < frame.size()) {
+                    return frame[index];
+                }
+            }
+            auto const& globals = Config::get().globals();
+            if (auto it = globals.find(name, hash); it != globals.end()) {
+                return it->second;
+            }
+            return null;
+        };
+
+        // lazy variables are computed once per run, sub-templates share the results
+        detail::LazyCache lazyValues;
+        // lazy arguments cannot fail the call themselves, the first error they hit is reported after it
+        std::optional<RuntimeError> lazyError;
+        auto lookup = [&](uint32_t name, uint32_t slot) -> Value const& {
+            return lazyValues.resolve(find(name, slot));
+        };
+
+        // the slot of the variable a path starts at is kept in the tree, names[b] is used without a frame
+        auto follow = [&](Instruction const& instruction, Value& temporary) -> Value const* {
+            auto const& path = *m_paths[instruction.a];
+            auto slot = path.root().slot() == VariableSchema::NO_SLOT ? NO_SLOT : static_cast<uint32_t>(path.root().slot());
+            return Visitor::follow(path, lookup(instruction.b, slot), temporary, lazyValues);
+        };
+
+// operators with a kernel try it first and fall back to the generic operator when the operands do not fit
+#define BINARY_KERNEL(Token) \
+        if (instruction.a != 0) { \
+            Value result; \
+            if (applyKernel(static_cast<Kernel>(instruction.a), TokenType::Token, lhs, stack.back(), result)) { \
+                lhs = std::move(result); \
+                stack.pop_back(); \
+                break; \
+            } \
+        }
+#define BINARY_OP(Code, Token, op) \
+    case OpCode::Code: { \
+        auto& lhs = stack[stack.size() - 2]; \
+        BINARY_KERNEL(Token) \
+        lhs = lhs op stack.back(); \
+        stack.pop_back(); \
+    } break;
+#define BINARY_OP_UNWRAP(Code, Token, op) \
+    case OpCode::Code: { \
+        auto& lhs = stack[stack.size() - 2]; \
+        BINARY_KERNEL(Token) \
+        auto res = std::move(lhs) op stack.back(); \
+        if (res.isErr()) { \
+            return error(ip, fmt::format("RuntimeError: {}", res.unwrapErr())); \
+        } \
+        lhs = std::move(res.unwrap()); \
+        stack.pop_back(); \
+    } break;
+
+        size_t const size = m_code.size();
+        for (size_t ip = 0; ip < size; ++ip) {
+            auto const& instruction = m_code[ip];
+            switch (instruction.opcode) {
+                case OpCode::Constant:
+                    stack.push_back(m_constants[instruction.a]);
+                    break;
+
+                case OpCode::Load:
+                    stack.push_back(lookup(instruction.a, NO_SLOT));
+                    break;
+
+                case OpCode::LoadSlot:
+                    stack.push_back(lookup(instruction.b, instruction.a));
+                    break;
+
+                case OpCode::Access: {
+                    // read through a const reference, the mutating operator[] would clone the object to insert a null member
+                    // lazy members are computed once per run, like lazy variables
+                    auto& object = stack.back();
+                    if (object.isObject()) {
+                        auto const& members = object.getObject();
+                        auto it = members.find(m_names[instruction.a], m_nameHashes[instruction.a]);
+                        object = it == members.end() ? Value() : Value(lazyValues.resolve(it->second));
+                    } else {
+                        object = Value(lazyValues.resolve(std::as_const(object)[m_names[instruction.a]]));
+                    }
+                } break;
+
+                case OpCode::LoadPath: {
+                    // walk the path by reference, only the value at its end is copied onto the stack
+                    Value temporary;
+                    auto const* value = follow(instruction, temporary);
+                    stack.push_back(value == &temporary ? std::move(temporary) : *value);
+                } break;
+
+                case OpCode::Index: {
+                    auto& object = stack[stack.size() - 2];
+                    object = Value(lazyValues.resolve(object.at(stack.back())));
+                    stack.pop_back();
+                } break;
+
+                BINARY_OP_UNWRAP(Add, PLUS, +)
+                BINARY_OP_UNWRAP(Subtract, MINUS, -)
+                BINARY_OP_UNWRAP(Multiply, STAR, *)
+                BINARY_OP_UNWRAP(Divide, SLASH, /)
+                BINARY_OP_UNWRAP(Modulo, PERCENT, %)
+                BINARY_OP_UNWRAP(Power, CARET, ^)
+                BINARY_OP(Equal, EQUAL_EQUAL, ==)
+                BINARY_OP(NotEqual, NOT_EQUAL, !=)
+                BINARY_OP(Less, LESS, <)
+                BINARY_OP(Greater, GREATER, >)
+                BINARY_OP(LessEqual, LESS_EQUAL, <=)
+                BINARY_OP(GreaterEqual, GREATER_EQUAL, >=)
+
+                case OpCode::Negate:
+                    stack.back() = -stack.back();
+                    break;
+
+                case OpCode::Not:
+                    stack.back() = !stack.back();
+                    break;
+
+                case OpCode::Truthy:
+                    stack.back() = stack.back().toBoolean();
+                    break;
+
+                case OpCode::Interpolate: {
+                    auto res = Visitor(variables, frame, schema, precision, &lazyValues).interpolate(stack.back().toString());
+                    if (res.isErr()) {
+                        return error(ip, std::move(res.unwrapErr()));
+                    }
+                    stack.back() = std::move(res.unwrap());
+                } break;
+
+                case OpCode::Resolve: {
+                    auto const& binding = m_bindings[instruction.a];
+                    auto const* function = binding.resolve();
+                    if (!function) {
+                        return error(ip, fmt::format("RuntimeError: Function '{}' not found", binding.name()));
+                    }
+                    functions.push_back(Callee { function, binding.lazyParameters() });
+                } break;
+
+                case OpCode::ResolveDynamic: {
+                    auto name = stack.back().toString();
+                    stack.pop_back();
+
+                    auto const* function = Config::get().getFunction(name);
+                    if (!function) {
+                        return error(ip, fmt::format("RuntimeError: Function '{}' not found", name));
+                    }
+                    functions.push_back(Callee { function, Config::get().lazyParameters(name) });
+                } break;
+
+                case OpCode::LazyArgument: {
+                    auto const& argument = m_lazyArguments[instruction.a];
+                    if (!isLazyParameter(functions.back().lazy, argument.index)) {
+                        break;
+                    }
+
+                    // lazy arguments are rare, so they go through the tree walker instead of a code range of their own
+                    // the argument is evaluated on the first read, later reads reuse the result
+                    auto const* node = argument.node;
+                    stack.push_back(Value::lazy([&, node, result = std::optional<Value>()]() mutable {
+                        if (!result) {
+                            auto res = Visitor(variables, frame, schema, precision, &lazyValues).visit(*node);
+                            if (res.isErr()) {
+                                if (!lazyError) lazyError = std::move(res.unwrapErr());
+                                result = Value();
+                            } else {
+                                result = std::move(res.unwrap());
+                            }
+                        }
+                        return *result;
+                    }));
+                    ip = instruction.b - 1;
+                } break;
+
+                case OpCode::Call: {
+                    // arguments are already laid out contiguously on top of the stack
+                    auto const* function = functions.back().function;
+                    functions.pop_back();
+
+                    auto args = std::span<Value const>(stack.data() + stack.size() - instruction.b, instruction.b);
+                    // loads never push lazy values, so every lazy argument was pushed by LazyArgument
+                    bool lazyArguments = std::ranges::any_of(args, &Value::isLazy);
+                    auto res = (*function)(args);
+                    if (res.isErr()) {
+                        return error(ip, fmt::format("RuntimeError: {}", res.unwrapErr()));
+                    }
+
+                    // lazy arguments handed back, as is or inside a container, have to be evaluated while their variables are still around
+                    auto result = std::move(res.unwrap());
+                    if (lazyArguments) {
+                        result.resolveAll();
+                    } else if (result.isLazy()) {
+                        result = result.resolve();
+                    }
+                    stack.resize(stack.size() - instruction.b);
+                    stack.push_back(std::move(result));
+                    if (lazyError) {
+                        return geode::Err(std::move(*lazyError));
+                    }
+                } break;
+
+                case OpCode::Jump:
+                    ip = instruction.a - 1;
+                    break;
+
+                case OpCode::JumpIfFalse: {
+                    bool condition = stack.back().toBoolean();
+                    stack.pop_back();
+                    if (!condition) {
+                        ip = instruction.a - 1;
+                    }
+                } break;
+
+                case OpCode::JumpIfFalseOrPop:
+                case OpCode::JumpIfTrueOrPop: {
+                    bool decided = instruction.opcode == OpCode::JumpIfTrueOrPop;
+                    if (stack.back().toBoolean() == decided) {
+                        stack.back() = decided;
+                        ip = instruction.a - 1;
+                    } else {
+                        stack.pop_back();
+                    }
+                } break;
+
+                case OpCode::Append:
+                    stack.back().appendTo(out, precision);
+                    stack.pop_back();
+                    break;
+
+                case OpCode::AppendConstant:
+                    m_constants[instruction.a].appendTo(out, precision);
+                    break;
+
+                case OpCode::AppendVariable:
+                    lookup(instruction.b, instruction.a).appendTo(out, precision);
+                    break;
+
+                case OpCode::AppendPath: {
+                    Value temporary;
+                    follow(instruction, temporary)->appendTo(out, precision);
+                } break;
+
+                case OpCode::Raise:
+                    return error(ip, m_constants[instruction.a].toString());
+            }
+        }
+
+#undef BINARY_KERNEL
+#undef BINARY_OP
+#undef BINARY_OP_UNWRAP
+
+        if (result) {
+            *result = std::move(stack.back());
+        }
+        return geode::Ok();
+    }
+
+    std::string Chunk::toDebugString() const noexcept {
+        static constexpr std::array OPCODE_NAMES = {
+            "Constant", "Load", "LoadSlot", "Access", "Index", "LoadPath",
+            "Add", "Subtract", "Multiply", "Divide", "Modulo", "Power",
+            "Equal", "NotEqual", "Less", "Greater", "LessEqual", "GreaterEqual",
+            "Negate", "Not", "Truthy", "Interpolate",
+            "Resolve", "ResolveDynamic", "LazyArgument", "Call",
+            "Jump", "JumpIfFalse", "JumpIfFalseOrPop", "JumpIfTrueOrPop", "Append", "AppendConstant", "AppendVariable", "AppendPath", "Raise",
+        };
+
+        std::string result;
+        for (size_t i = 0; i < m_code.size(); ++i) {
+            auto const& instruction = m_code[i];
+            result += fmt::format("{:04} {:<14}", i, OPCODE_NAMES[static_cast<size_t>(instruction.opcode)]);
+            switch (instruction.opcode) {
+                case OpCode::Constant:
+                case OpCode::AppendConstant:
+                case OpCode::Raise:
+                    result += fmt::format(" {} ({})", instruction.a, m_constants[instruction.a].toString());
+                    break;
+                case OpCode::LoadSlot:
+                case OpCode::AppendVariable:
+                    result += fmt::format(" {} ({})", instruction.a, m_names[instruction.b]);
+                    break;
+                case OpCode::LoadPath:
+                case OpCode::AppendPath:
+                    result += fmt::format(" {} ({})", instruction.a, m_paths[instruction.a]->toDebugString());
+                    break;
+                case OpCode::Load:
+                case OpCode::Access:
+                    result += fmt::format(" {} ({})", instruction.a, m_names[instruction.a]);
+                    break;
+                case OpCode::Resolve:
+                    result += fmt::format(" {} ({})", instruction.a, m_bindings[instruction.a].name());
+                    break;
+                case OpCode::Jump:
+                case OpCode::JumpIfFalse:
+                case OpCode::JumpIfFalseOrPop:
+                case OpCode::JumpIfTrueOrPop:
+                    result += fmt::format(" {}", instruction.a);
+                    break;
+                case OpCode::LazyArgument:
+                    result += fmt::format(" {} -> {}", m_lazyArguments[instruction.a].index, instruction.b);
+                    break;
+                case OpCode::Call:
+                    result += fmt::format(" {}", instruction.b);
+                    break;
+                default: break;
+            }
+            result += '\n';
+        }
+        return result;
+    }
+
+}
@@ -0,0 +1,130 @@
+#include <rift.hpp>
+#include <rift/cache.hpp>
+
+namespace rift {
+
+    ScriptCache& ScriptCache::get() noexcept {
+        static ScriptCache instance;
+        return instance;
+    }
+
+    size_t ScriptCache::hashKey(std::string_view source, bool directMode) noexcept {
+        auto hash = std::hash<std::string_view>{}(source);
+        return directMode ? ~hash : hash;
+    }
+
+    ScriptCache::EntryList::iterator ScriptCache::find(size_t hash, std::string_view source, bool directMode) noexcept {
+        auto [begin, end] = m_index.equal_range(hash);
+        for (auto it = begin; it != end; ++it) {
+            auto const& entry = *it->second;
+            if (entry.directMode == directMode && entry.source == source) {
+                return it->second;
+            }
+        }
+        return m_entries.end();
+    }
+
+    void ScriptCache::erase(EntryList::iterator it) noexcept {
+        auto [begin, end] = m_index.equal_range(it->hash);
+        for (auto indexIt = begin; indexIt != end; ++indexIt) {
+            if (indexIt->second == it) {
+                m_index.erase(indexIt);
+                break;
+            }
+        }
+        m_stats.size -= it->size;
+        m_stats.entries--;
+        m_entries.erase(it);
+    }
+
+    void ScriptCache::evict() noexcept {
+        while (m_stats.size > m_capacity && !m_entries.empty()) {
+            erase(std::prev(m_entries.end()));
+            m_stats.evictions++;
+        }
+    }
+
+    ScriptCache::Result ScriptCache::compile(std::string_view source, bool directMode) noexcept {
+        auto hash = hashKey(source, directMode);
+
+        {
+            std::lock_guard lock(m_mutex);
+            if (auto it = find(hash, source, directMode); it != m_entries.end()) {
+                m_stats.hits++;
+                m_entries.splice(m_entries.begin(), m_entries, it);
+                return geode::Ok(it->script);
+            }
+            m_stats.misses++;
+        }
+
+        // compile outside the lock, so nested evaluations are not serialized behind us
+        auto result = rift::compile(source, directMode);
+        if (result.isErr()) {
+            return geode::Err(std::move(result.unwrapErr()));
+        }
+
+        SharedScript script = std::move(result.unwrap());
+        size_t size = sizeof(Entry) + source.size() + sizeof(Script) + script->arena().capacity();
+
+        std::lock_guard lock(m_mutex);
+        if (size > m_capacity) {
+            return geode::Ok(std::move(script));
+        }
+
+        // another thread might have compiled the same source in the meantime
+        if (auto it = find(hash, source, directMode); it != m_entries.end()) {
+            m_entries.splice(m_entries.begin(), m_entries, it);
+            return geode::Ok(it->script);
+        }
+
+        m_entries.push_front(Entry { hash, directMode, std::string(source), script, size });
+        m_index.emplace(hash, m_entries.begin());
+        m_stats.size += size;
+        m_stats.entries++;
+        evict();
+
+        return geode::Ok(std::move(script));
+    }
+
+    bool ScriptCache::invalidate(std::string_view source, bool directMode) noexcept {
+        std::lock_guard lock(m_mutex);
+        auto it = find(hashKey(source, directMode), source, directMode);
+        if (it == m_entries.end()) {
+            return false;
+        }
+        erase(it);
+        return true;
+    }
+
+    void ScriptCache::clear() noexcept {
+        std::lock_guard lock(m_mutex);
+        m_entries.clear();
+        m_index.clear();
+        m_stats.entries = 0;
+        m_stats.size = 0;
+    }
+
+    void ScriptCache::setCapacity(size_t bytes) noexcept {
+        std::lock_guard lock(m_mutex);
+        m_capacity = bytes;
+        evict();
+    }
+
+    size_t ScriptCache::capacity() const noexcept {
+        std::lock_guard lock(m_mutex);
+        return m_capacity;
+    }
+
+    ScriptCache::Stats ScriptCache::stats() const noexcept {
+        std::lock_guard lock(m_mutex);
+        return m_stats;
+    }
+
+    void ScriptCache::resetStats() noexcept {
+        std::lock_guard lock(m_mutex);
+        m_stats.hits = 0;
+        m_stats.misses = 0;
+        m_stats.evictions = 0;
+    }
+
+}
@@ -265,6 +265,31 @@ namespace rift {
             return geode::Ok(sum / args.size());
         }
 
+        // Lazy functions, arguments are only evaluated when resolved
+
+        RuntimeFuncResult coalesce(std::span<Value const> args) noexcept {
+            for (auto const& arg : args) {
+                auto value = arg.resolve();
+                if (!value.isNull()) {
+                    return geode::Ok(std::move(value));
+                }
+            }
+            return geode::Ok(Value());
+        }
+
+        RuntimeFuncResult choose(std::span<Value const> args) noexcept {
+            if (args.empty()) {
+                return geode::Err("Expected at least one argument");
+            }
+
+            // the index picks one of the remaining arguments, starting at 0
+            auto index = args[0].toInteger();
+            if (index < 0 || index >= static_cast<int64_t>(args.size() - 1)) {
+                return geode::Ok(Value());
+            }
+            return geode::Ok(args[static_cast<size_t>(index) + 1].resolve());
+        }
+
         int64_t randomInt(int64_t min, int64_t max) noexcept {
             static std::random_device rd;
             static std::mt19937 gen(rd());
@@ -305,61 +330,65 @@ namespace rift {
             { "nan", std::numeric_limits<double>::quiet_NaN() },
         };
 
-        // Register built-in functions
-        makeFunction("int", builtins::intCast);
-        makeFunction("float", builtins::floatCast);
-        makeFunction("str", builtins::strCast);
-        makeFunction("len", builtins::length);
-        makeFunction("toUpper", builtins::toUpper);
-        makeFunction("toLower", builtins::toLower);
-        registerFunction("substr", builtins::substr);
-        makeFunction("trim", builtins::trim);
-        makeFunction("replace", builtins::replace);
-        makeFunction("find", builtins::find);
-        makeFunction("round", builtins::round);
-        makeFunction("floor", builtins::floor);
-        makeFunction("ceil", builtins::ceil);
-        makeFunction("precision", builtins::precision);
-        makeFunction("ordinal", builtins::ordinal);
-        makeFunction("duration", builtins::duration);
+        // Register built-in functions, everything except the random generators is pure
+        makeFunction("int", builtins::intCast, true);
+        makeFunction("float", builtins::floatCast, true);
+        makeFunction("str", builtins::strCast, true);
+        makeFunction("len", builtins::length, true);
+        makeFunction("toUpper", builtins::toUpper, true);
+        makeFunction("toLower", builtins::toLower, true);
+        registerFunction("substr", builtins::substr, true);
+        makeFunction("trim", builtins::trim, true);
+        makeFunction("replace", builtins::replace, true);
+        makeFunction("find", builtins::find, true);
+        makeFunction("round", builtins::round, true);
+        makeFunction("floor", builtins::floor, true);
+        makeFunction("ceil", builtins::ceil, true);
+        makeFunction("precision", builtins::precision, true);
+        makeFunction("ordinal", builtins::ordinal, true);
+        makeFunction("duration", builtins::duration, true);
         makeFunction("randomInt", builtins::randomInt);
         makeFunction("randomFloat", builtins::randomFloat);
-        registerFunction("middlePad", builtins::middlePad);
-        registerFunction("leftPad", builtins::leftPad);
-        registerFunction("rightPad", builtins::rightPad);
-        registerFunction("min", builtins::min);
-        registerFunction("max", builtins::max);
-        registerFunction("sum", builtins::sum);
-        registerFunction("avg", builtins::avg);
+        registerFunction("middlePad", builtins::middlePad, true);
+        registerFunction("leftPad", builtins::leftPad, true);
+        registerFunction("rightPad", builtins::rightPad, true);
+        registerFunction("min", builtins::min, true);
+        registerFunction("max", builtins::max, true);
+        registerFunction("sum", builtins::sum, true);
+        registerFunction("avg", builtins::avg, true);
+        setReturnType("sum", Value::Type::Float);
+        setReturnType("avg", Value::Type::Float);
+        registerFunction("coalesce", builtins::coalesce, true, ALL_LAZY);
+        registerFunction("choose", builtins::choose, true, ALL_LAZY & ~LazyParameters(1));
         registerFunction("random", builtins::random);
-        makeFunction<double, double>("sqrt", std::sqrt);
-        makeFunction<double, double>("cbrt", std::cbrt);
-        makeFunction<double, double>("abs", std::abs);
-        makeFunction<double, double>("sin", std::sin);
-        makeFunction<double, double>("cos", std::cos);
-        makeFunction<double, double>("tan", std::tan);
-        makeFunction<double, double>("asin", std::asin);
-        makeFunction<double, double>("acos", std::acos);
-        makeFunction<double, double>("atan", std::atan);
-        makeFunction<double, double>("sinh", std::sinh);
-        makeFunction<double, double>("cosh", std::cosh);
-        makeFunction<double, double>("tanh", std::tanh);
-        makeFunction<double, double>("asinh", std::asinh);
-        makeFunction<double, double>("acosh", std::acosh);
-        makeFunction<double, double>("atanh", std::atanh);
-        makeFunction<double, double>("exp", std::exp);
-        makeFunction<double, double>("log", std::log);
-        makeFunction<double, double>("log10", std::log10);
-        makeFunction<double, double, double>("pow", std::pow);
-        makeFunction<double, double, double>("hypot", std::hypot);
-        makeFunction<double, double, double>("atan2", std::atan2);
+        makeFunction<double, double>("sqrt", std::sqrt, true);
+        makeFunction<double, double>("cbrt", std::cbrt, true);
+        makeFunction<double, double>("abs", std::abs, true);
+        makeFunction<double, double>("sin", std::sin, true);
+        makeFunction<double, double>("cos", std::cos, true);
+        makeFunction<double, double>("tan", std::tan, true);
+        makeFunction<double, double>("asin", std::asin, true);
+        makeFunction<double, double>("acos", std::acos, true);
+        makeFunction<double, double>("atan", std::atan, true);
+        makeFunction<double, double>("sinh", std::sinh, true);
+        makeFunction<double, double>("cosh", std::cosh, true);
+        makeFunction<double, double>("tanh", std::tanh, true);
+        makeFunction<double, double>("asinh", std::asinh, true);
+        makeFunction<double, double>("acosh", std::acosh, true);
+        makeFunction<double, double>("atanh", std::atanh, true);
+        makeFunction<double, double>("exp", std::exp, true);
+        makeFunction<double, double>("log", std::log, true);
+        makeFunction<double, double>("log10", std::log10, true);
+        makeFunction<double, double, double>("pow", std::pow, true);
+        makeFunction<double, double, double>("hypot", std::hypot, true);
+        makeFunction<double, double, double>("atan2", std::atan2, true);
 
         // Function aliases
-        makeFunction("ord", builtins::ordinal);
-        registerFunction("lpad", builtins::leftPad);
-        registerFunction("mpad", builtins::middlePad);
-        registerFunction("rpad", builtins::rightPad);
-        makeFunction("prec", builtins::precision);
+        makeFunction("ord", builtins::ordinal, true);
+        registerFunction("lpad", builtins::leftPad, true);
+        registerFunction("mpad", builtins::middlePad, true);
+        registerFunction("rpad", builtins::rightPad, true);
+        makeFunction("prec", builtins::precision, true);
         registerFunction("rand", builtins::random);
     }
 
@@ -368,4 +397,18 @@ namespace rift {
         return instance;
     }
 
+    RuntimeFunction const* FunctionBinding::resolve() const noexcept {
+        auto const& config = Config::get();
+        auto generation = config.generation();
+        if (m_generation.load(std::memory_order_acquire) == generation) {
+            return m_function.load(std::memory_order_relaxed);
+        }
+
+        auto const* function = config.getFunction(m_name);
+        m_function.store(function, std::memory_order_relaxed);
+        m_lazy.store(config.lazyParameters(m_name), std::memory_order_relaxed);
+        m_generation.store(generation, std::memory_order_release);
+        return function;
+    }
+
 }
@@ -0,0 +1,170 @@
+#include <rift/inference.hpp>
+#include <rift/config.hpp>
+
+#include <rift/nodes/accessor.hpp>
+#include <rift/nodes/binary.hpp>
+#include <rift/nodes/call.hpp>
+#include <rift/nodes/identifier.hpp>
+#include <rift/nodes/indexer.hpp>
+#include <rift/nodes/root.hpp>
+#include <rift/nodes/ternary.hpp>
+#include <rift/nodes/unary.hpp>
+#include <rift/nodes/value.hpp>
+
+namespace rift {
+
+    using ValueType = Value::Type;
+
+    static bool isNumber(std::optional<ValueType> type) noexcept {
+        return type == ValueType::Integer || type == ValueType::Float;
+    }
+
+    size_t TypeInference::annotate(Node& root) noexcept {
+        m_annotated = 0;
+        (void) infer(root);
+        return m_annotated;
+    }
+
+    std::optional<ValueType> TypeInference::infer(Node& node) noexcept {
+        switch (node.type()) {
+            case Node::Type::Segment:
+                return ValueType::String;
+            case Node::Type::Value:
+                return static_cast<ValueNode const&>(node).value().type();
+            case Node::Type::Root:
+                for (auto* child : static_cast<RootNode&>(node).m_nodes) {
+                    (void) infer(*child);
+                }
+                return ValueType::String;
+            case Node::Type::Identifier: {
+                // variables without a slot come from an object and can hold anything
+                auto slot = static_cast<IdentifierNode const&>(node).slot();
+                return slot == VariableSchema::NO_SLOT ? std::nullopt : m_schema.type(slot);
+            }
+            case Node::Type::Binary: {
+                auto& binary = static_cast<BinaryNode&>(node);
+                auto lhs = infer(*binary.m_lhs);
+                auto rhs = infer(*binary.m_rhs);
+                binary.m_kernel = pickKernel(binary.m_op, lhs, rhs);
+                if (binary.m_kernel != Kernel::Generic) {
+                    m_annotated++;
+                }
+                return binaryType(binary.m_op, lhs, rhs);
+            }
+            case Node::Type::Unary: {
+                auto& unary = static_cast<UnaryNode&>(node);
+                auto value = infer(*unary.m_value);
+                switch (unary.op()) {
+                    case TokenType::PLUS:
+                        return value;
+                    case TokenType::MINUS:
+                        // everything but a float is negated as an integer
+                        if (!value) return std::nullopt;
+                        return value == ValueType::Float ? ValueType::Float : ValueType::Integer;
+                    case TokenType::NOT:
+                        return ValueType::Boolean;
+                    case TokenType::DOLLAR:
+                        return ValueType::String;
+                    default:
+                        return std::nullopt;
+                }
+            }
+            case Node::Type::Ternary: {
+                auto& ternary = static_cast<TernaryNode&>(node);
+                (void) infer(*ternary.m_cond);
+                auto trueType = infer(*ternary.m_trueBranch);
+                // a missing false branch evaluates to an empty string
+                auto falseType = ternary.m_falseBranch ? infer(*ternary.m_falseBranch) : ValueType::String;
+                return trueType == falseType ? trueType : std::nullopt;
+            }
+            case Node::Type::Call: {
+                auto& call = static_cast<CallNode&>(node);
+                if (!call.binding()) {
+                    (void) infer(*call.m_node);
+                }
+                for (auto* arg : call.m_args) {
+                    (void) infer(*arg);
+                }
+                return call.binding() ? Config::get().returnType(call.binding()->name()) : std::nullopt;
+            }
+            case Node::Type::Accessor:
+                (void) infer(*static_cast<AccessorNode&>(node).m_node);
+                return std::nullopt;
+            case Node::Type::Indexer: {
+                auto& indexer = static_cast<IndexerNode&>(node);
+                (void) infer(*indexer.m_node);
+                (void) infer(*indexer.m_index);
+                return std::nullopt;
+            }
+            default:
+                return std::nullopt;
+        }
+    }
+
+    std::optional<ValueType> TypeInference::binaryType(TokenType op, std::optional<ValueType> lhs, std::optional<ValueType> rhs) noexcept {
+        bool integers = lhs == ValueType::Integer && rhs == ValueType::Integer;
+        bool floats = isNumber(lhs) && isNumber(rhs) && !integers;
+        switch (op) {
+            case TokenType::EQUAL_EQUAL:
+            case TokenType::NOT_EQUAL:
+            case TokenType::LESS:
+            case TokenType::GREATER:
+            case TokenType::LESS_EQUAL:
+            case TokenType::GREATER_EQUAL:
+            case TokenType::AND:
+            case TokenType::OR:
+                return ValueType::Boolean;
+            case TokenType::PLUS: {
+                // strings concatenate with anything but null and containers
+                auto scalar = [](std::optional<ValueType> type) {
+                    return type == ValueType::String || type == ValueType::Integer || type == ValueType::Float || type == ValueType::Boolean;
+                };
+                if ((lhs == ValueType::String && scalar(rhs)) || (rhs == ValueType::String && scalar(lhs))) {
+                    return ValueType::String;
+                }
+            } [[fallthrough]];
+            case TokenType::MINUS:
+            case TokenType::STAR:
+                if (integers) return ValueType::Integer;
+                if (floats) return ValueType::Float;
+                return std::nullopt;
+            case TokenType::SLASH:
+            case TokenType::PERCENT:
+                // integers divided by zero produce a float
+                if (floats) return ValueType::Float;
+                return std::nullopt;
+            case TokenType::CARET:
+                if (integers || floats) return ValueType::Float;
+                return std::nullopt;
+            default:
+                return std::nullopt;
+        }
+    }
+
+    Kernel TypeInference::pickKernel(TokenType op, std::optional<ValueType> lhs, std::optional<ValueType> rhs) noexcept {
+        switch (op) {
+            case TokenType::PLUS:
+            case TokenType::MINUS:
+            case TokenType::STAR:
+            case TokenType::SLASH:
+            case TokenType::PERCENT:
+            case TokenType::CARET:
+            case TokenType::LESS:
+            case TokenType::GREATER:
+            case TokenType::LESS_EQUAL:
+            case TokenType::GREATER_EQUAL:
+                break;
+            case TokenType::EQUAL_EQUAL:
+            case TokenType::NOT_EQUAL:
+                if (lhs == ValueType::String && rhs == ValueType::String) return Kernel::String;
+                break;
+            default:
+                return Kernel::Generic;
+        }
+
+        if (lhs == ValueType::Integer && rhs == ValueType::Integer) return Kernel::Integer;
+        if (isNumber(lhs) && isNumber(rhs)) return Kernel::Float;
+        return Kernel::Generic;
+    }
+
+}
@@ -16,7 +16,9 @@ namespace rift {
 
     LexerResult Lexer::nextSegment() {
         size_t start = m_index;
+        bool escaped = false;
         while (!isEnd()) {
+            escaped |= peek() == '\\';
             if (peek() == '{') {
                 if (m_index == start) {
                     m_expressionDepth++;
@@ -27,7 +29,7 @@ namespace rift {
             m_index++;
         }
 
-        return geode::Ok(Token { TokenType::SEGMENT, escapedString(m_source.substr(start, m_index - start)), start });
+        return geode::Ok(Token { TokenType::SEGMENT, m_source.substr(start, m_index - start), start, m_index, escaped });
     }
 
     LexerResult Lexer::nextExpression() {
@@ -202,8 +204,10 @@ namespace rift {
 
     LexerResult Lexer::string(char quote) {
         size_t start = m_index;
+        bool escaped = false;
         while (!isEnd() && peek() != quote) {
             if (peek() == '\\') {
+                escaped = true;
                 m_index++;
                 if (isEnd()) {
                     return geode::Err(CompileError(
@@ -226,6 +230,7 @@ namespace rift {
             }
         }
 
-        return geode::Ok(Token { TokenType::STRING, escapedString(m_source.substr(start, m_index++ - start)), start });
+        auto value = m_source.substr(start, m_index - start);
+        return geode::Ok(Token { TokenType::STRING, value, start, m_index++, escaped });
     }
 }
@@ -0,0 +1,64 @@
+#include <rift/native.hpp>
+#include <rift/value.hpp>
+
+#include <array>
+#include <atomic>
+
+namespace rift {
+
+    namespace {
+        // values store the id of their type instead of a pointer, so a handle still fits next to the object pointer
+        std::array<std::atomic<NativeType const*>, NativeType::MAX_TYPES> s_types {};
+        std::atomic<uint32_t> s_nextId = 1;
+    }
+
+    NativeType::NativeType(
+        std::string_view name, std::span<NativeProperty const> properties, Indexer indexer
+    ) noexcept : m_name(name), m_properties(properties), m_indexer(indexer), m_id(0) {
+        auto id = s_nextId.fetch_add(1, std::memory_order_relaxed);
+        if (id < MAX_TYPES) {
+            s_types[id].store(this, std::memory_order_release);
+            m_id = id;
+        }
+    }
+
+    NativeType::~NativeType() noexcept {
+        if (m_id != 0) {
+            s_types[m_id].store(nullptr, std::memory_order_release);
+        }
+    }
+
+    NativeType const* NativeType::fromId(uint32_t id) noexcept {
+        if (id == 0 || id >= MAX_TYPES) return nullptr;
+        return s_types[id].load(std::memory_order_acquire);
+    }
+
+    NativeProperty const* NativeType::property(std::string_view name) const noexcept {
+        // tables are small, a linear scan beats hashing the name
+        for (auto const& property : m_properties) {
+            if (property.name == name) {
+                return &property;
+            }
+        }
+        return nullptr;
+    }
+
+    Value NativeType::get(void const* object, std::string_view name) const noexcept {
+        auto const* property = this->property(name);
+        if (!property || !property->get) {
+            return {};
+        }
+        return property->get(object);
+    }
+
+    Value NativeType::at(void const* object, Value const& key) const noexcept {
+        if (m_indexer) {
+            return m_indexer(object, key);
+        }
+        if (key.isString()) {
+            return get(object, key.getStringView());
+        }
+        return get(object, key.toString());
+    }
+
+}
@@ -0,0 +1,290 @@
+#include <rift/optimizer.hpp>
+#include <rift/config.hpp>
+#include <rift/visitor.hpp>
+
+#include <rift/nodes/path.hpp>
+#include <rift/nodes/segment.hpp>
+#include <rift/nodes/value.hpp>
+
+#include <vector>
+
+namespace rift {
+
+    size_t Optimizer::optimize(Node*& root) noexcept {
+        m_removed = 0;
+        if (m_level != OptimizationLevel::None) {
+            visit(root);
+        }
+        return m_removed;
+    }
+
+    void Optimizer::visit(Node*& node) noexcept {
+        switch (node->type()) {
+            case Node::Type::Root: {
+                auto& root = static_cast<RootNode&>(*node);
+                for (auto& child : root.m_nodes) {
+                    visit(child);
+                }
+                mergeSegments(root);
+
+                // a template that turned out fully static is just its text
+                if (root.m_nodes.size() == 1 && root.m_nodes[0]->type() == Node::Type::Segment) {
+                    hoist(node, root.m_nodes[0]);
+                }
+            } break;
+
+            case Node::Type::Identifier: {
+                if (m_level < OptimizationLevel::Aggressive) break;
+                // variables declared in the schema are always supplied by the frame
+                auto const& identifier = static_cast<IdentifierNode const&>(*node);
+                if (identifier.slot() != VariableSchema::NO_SLOT) break;
+                auto const& globals = Config::get().globals();
+                auto it = globals.find(identifier.name());
+                // lazy globals are computed on every evaluation, so they cannot be baked in
+                if (it != globals.end() && !it->second.isLazy()) {
+                    replace(node, m_arena.make<ValueNode>(it->second, node->fromIndex(), node->toIndex()));
+                }
+            } break;
+
+            case Node::Type::Binary: {
+                auto& binary = static_cast<BinaryNode&>(*node);
+                visit(binary.m_lhs);
+                visit(binary.m_rhs);
+                if (isConstant(binary.m_lhs) && isConstant(binary.m_rhs)) {
+                    fold(node);
+                    break;
+                }
+
+                // a constant left side that decides a logical operator makes the right side dead code
+                if ((binary.op() == TokenType::AND || binary.op() == TokenType::OR) && isConstant(binary.m_lhs)) {
+                    bool decided = binary.op() == TokenType::OR;
+                    if (static_cast<ValueNode const&>(*binary.m_lhs).value().toBoolean() == decided) {
+                        replace(node, m_arena.make<ValueNode>(Value(decided), node->fromIndex(), node->toIndex()));
+                    }
+                }
+            } break;
+
+            case Node::Type::Unary: {
+                auto& unary = static_cast<UnaryNode&>(*node);
+                visit(unary.m_value);
+                // interpolation renders a template that may reference variables
+                if (unary.op() != TokenType::DOLLAR && isConstant(unary.m_value)) {
+                    fold(node);
+                }
+            } break;
+
+            case Node::Type::Ternary: {
+                auto& ternary = static_cast<TernaryNode&>(*node);
+                visit(ternary.m_cond);
+                visit(ternary.m_trueBranch);
+                if (ternary.m_falseBranch) {
+                    visit(ternary.m_falseBranch);
+                }
+
+                if (!isConstant(ternary.m_cond)) break;
+
+                // prune the branch that can never be taken
+                if (static_cast<ValueNode const&>(*ternary.m_cond).value().toBoolean()) {
+                    hoist(node, ternary.m_trueBranch);
+                } else if (ternary.m_falseBranch) {
+                    hoist(node, ternary.m_falseBranch);
+                } else {
+                    replace(node, m_arena.make<ValueNode>(Value(""), node->fromIndex(), node->toIndex()));
+                }
+            } break;
+
+            case Node::Type::Call: {
+                auto& call = static_cast<CallNode&>(*node);
+                bool isNamed = call.m_node->type() == Node::Type::Identifier;
+                if (!isNamed) {
+                    visit(call.m_node);
+                }
+
+                bool constantArgs = true;
+                for (auto& arg : call.m_args) {
+                    visit(arg);
+                    constantArgs = constantArgs && isConstant(arg);
+                }
+
+                if (m_level < OptimizationLevel::Aggressive || !isNamed || !constantArgs) break;
+                if (Config::get().isPure(static_cast<IdentifierNode const&>(*call.m_node).name())) {
+                    fold(node);
+                }
+            } break;
+
+            case Node::Type::Accessor: {
+                auto& accessor = static_cast<AccessorNode&>(*node);
+                visit(accessor.m_node);
+                if (isConstant(accessor.m_node)) {
+                    fold(node);
+                    break;
+                }
+                extendPath(node, accessor.m_node, PathStep { PathStep::Kind::Member, accessor.m_name, accessor.m_hash });
+            } break;
+
+            case Node::Type::Indexer: {
+                auto& indexer = static_cast<IndexerNode&>(*node);
+                visit(indexer.m_node);
+                visit(indexer.m_index);
+                if (!isConstant(indexer.m_index)) break;
+                if (isConstant(indexer.m_node)) {
+                    fold(node);
+                    break;
+                }
+
+                auto const& key = static_cast<ValueNode const&>(*indexer.m_index).value();
+                auto name = m_arena.copy(key.toString());
+                extendPath(node, indexer.m_node, PathStep {
+                    PathStep::Kind::Index, name, Object::hash(name), key.toInteger(), &key
+                });
+            } break;
+
+            default: break;
+        }
+    }
+
+    /// @brief Returns true if the node renders the same text for every script.
+    /// Floats are left alone, their output depends on the precision of the script that renders them.
+    static bool isMergeable(Node const& node) noexcept {
+        if (node.type() == Node::Type::Segment) return true;
+        if (node.type() != Node::Type::Value) return false;
+        return !static_cast<ValueNode const&>(node).value().isFloat();
+    }
+
+    void Optimizer::mergeSegments(RootNode& root) noexcept {
+        // the merged list is never longer than the original one, so it is compacted in place
+        auto& nodes = root.m_nodes;
+        size_t size = 0;
+
+        size_t i = 0;
+        while (i < nodes.size()) {
+            auto* first = nodes[i];
+            bool isStatic = isMergeable(*first);
+            if (!isStatic) {
+                nodes[size++] = first;
+                i++;
+                continue;
+            }
+
+            // collect the run of static nodes and render it once
+            std::string text;
+            size_t from = first->fromIndex(), to = first->toIndex();
+            size_t count = 0;
+            for (; i < nodes.size(); ++i, ++count) {
+                auto const* child = nodes[i];
+                if (!isMergeable(*child)) {
+                    break;
+                }
+                if (child->type() == Node::Type::Segment) {
+                    text += static_cast<SegmentNode const&>(*child).value();
+                } else {
+                    text += static_cast<ValueNode const&>(*child).value().toString();
+                }
+                to = child->toIndex();
+            }
+
+            if (count == 1 && first->type() == Node::Type::Segment) {
+                nodes[size++] = first;
+                continue;
+            }
+
+            nodes[size++] = m_arena.make<SegmentNode>(m_arena.copy(text), from, to);
+            m_removed += count - 1;
+        }
+
+        nodes = nodes.first(size);
+    }
+
+    void Optimizer::extendPath(Node*& node, Node const* target, PathStep step) noexcept {
+        // chains are visited from the inside out, so the target is either the variable or the path built so far
+        IdentifierNode const* root = nullptr;
+        std::span<PathStep const> steps;
+        if (target->type() == Node::Type::Identifier) {
+            root = static_cast<IdentifierNode const*>(target);
+        } else if (target->type() == Node::Type::Path) {
+            auto const& path = static_cast<PathNode const&>(*target);
+            root = &path.root();
+            steps = path.steps();
+        } else {
+            return;
+        }
+
+        std::vector<PathStep> extended(steps.begin(), steps.end());
+        extended.push_back(step);
+        replace(node, m_arena.make<PathNode>(
+            root, m_arena.copy(std::span<PathStep const>(extended)), node->fromIndex(), node->toIndex()
+        ));
+    }
+
+    void Optimizer::fold(Node*& node) noexcept {
+        static Object const noVariables;
+        auto result = Visitor(noVariables).visit(*node);
+
+        // leave failing expressions alone, so the error is still reported when the script runs
+        if (result.isErr()) {
+            return;
+        }
+
+        replace(node, m_arena.make<ValueNode>(std::move(result.unwrap()), node->fromIndex(), node->toIndex()));
+    }
+
+    void Optimizer::replace(Node*& node, Node* replacement) noexcept {
+        // the old nodes stay in the arena until the script is destroyed, they are just unreachable
+        m_removed += countNodes(*node) - countNodes(*replacement);
+        node = replacement;
+    }
+
+    void Optimizer::hoist(Node*& node, Node* child) noexcept {
+        m_removed += countNodes(*node) - countNodes(*child);
+        node = child;
+    }
+
+    bool Optimizer::isConstant(Node const* node) noexcept {
+        return node->type() == Node::Type::Value;
+    }
+
+    size_t Optimizer::countNodes(Node const& node) noexcept {
+        switch (node.type()) {
+            case Node::Type::Root: {
+                size_t count = 1;
+                for (auto const& child : static_cast<RootNode const&>(node).nodes()) {
+                    count += countNodes(*child);
+                }
+                return count;
+            }
+            case Node::Type::Binary: {
+                auto const& binary = static_cast<BinaryNode const&>(node);
+                return 1 + countNodes(*binary.lhs()) + countNodes(*binary.rhs());
+            }
+            case Node::Type::Unary:
+                return 1 + countNodes(static_cast<UnaryNode const&>(node).value());
+            case Node::Type::Ternary: {
+                auto const& ternary = static_cast<TernaryNode const&>(node);
+                size_t count = 1 + countNodes(ternary.cond()) + countNodes(ternary.trueBranch());
+                if (ternary.hasFalseBranch()) {
+                    count += countNodes(ternary.falseBranch());
+                }
+                return count;
+            }
+            case Node::Type::Call: {
+                auto const& call = static_cast<CallNode const&>(node);
+                size_t count = 1 + countNodes(*call.node());
+                for (auto const& arg : call.args()) {
+                    count += countNodes(*arg);
+                }
+                return count;
+            }
+            case Node::Type::Accessor:
+                return 1 + countNodes(*static_cast<AccessorNode const&>(node).node());
+            case Node::Type::Indexer: {
+                auto const& indexer = static_cast<IndexerNode const&>(node);
+                return 1 + countNodes(*indexer.node()) + countNodes(*indexer.index());
+            }
+            case Node::Type::Path:
+                return 2;
+            default:
+                return 1;
+        }
+    }
+
+}
@@ -11,6 +11,8 @@
 #include <rift/nodes/unary.hpp>
 #include <rift/nodes/value.hpp>
 
+#include <algorithm>
+
 namespace rift {
 
     /** Parser syntax:
@@ -44,6 +46,10 @@ namespace rift {
      *  atom                    : IDENTIFIER | FLOAT | INTEGER | STRING
      *                          : LEFT_PAREN expression RIGHT_PAREN
      *
+     *  Expressions are not parsed with one function per rule, parseExpression() runs a single loop
+     *  that keeps operands, operators and open groups on explicit stacks and applies the rules above
+     *  through operator precedence. Deep nesting therefore never grows the call stack.
+     *
      **/
 
 #define UNWRAP_ADVANCE() \
@@ -79,8 +85,21 @@ namespace rift {
     EXPECT_TOKEN(expected) \
     UNWRAP_NEXT_TOKEN(name)
 
+    std::string_view Parser::text(Token const& token) noexcept {
+        if (!token.escaped) {
+            return token.value;
+        }
+
+        auto* data = static_cast<char*>(m_arena.allocate(token.value.size(), alignof(char)));
+        return { data, Lexer::unescape(token.value, data) };
+    }
+
     ParseResult Parser::parse() noexcept {
         UNWRAP_ADVANCE() // Get the first token
+        // enough for typical expressions, so the stacks are allocated once per parse instead of growing
+        m_operands.reserve(16);
+        m_operators.reserve(16);
+        m_groups.reserve(16);
         if (m_directMode) {
             return parseExpression();
         }
@@ -88,11 +107,13 @@ namespace rift {
     }
 
     ParseResult Parser::parseRoot() noexcept {
-        std::vector<std::unique_ptr<Node>> nodes;
+        std::vector<Node*> nodes;
         while (m_currentToken) {
             switch (m_currentToken.type) {
                 case TokenType::SEGMENT: {
-                    nodes.push_back(std::make_unique<SegmentNode>(m_currentToken));
+                    nodes.push_back(m_arena.make<SegmentNode>(
+                        text(m_currentToken), m_currentToken.fromIndex, m_currentToken.toIndex
+                    ));
                     UNWRAP_ADVANCE()
                 } break;
                 case TokenType::LEFT_BRACE: {
@@ -101,7 +122,7 @@ namespace rift {
                     if (res.isErr()) {
                         return res;
                     }
-                    nodes.push_back(std::move(res.unwrap()));
+                    nodes.push_back(res.unwrap());
                     CONSUME_TOKEN(TokenType::RIGHT_BRACE);
                 } break;
                 default: {
@@ -117,357 +138,316 @@ namespace rift {
 
         // if we only have one node, return it directly
         if (nodes.size() == 1) {
-            return geode::Ok(std::move(nodes[0]));
+            return geode::Ok(nodes[0]);
         }
 
         // otherwise, create a root node with all the segments
-        return geode::Ok(std::make_unique<RootNode>(std::move(nodes), 0, m_lexer.m_source.size()));
-    }
-
-    ParseResult Parser::parseExpression() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseBooleanExpression();
-        if (res.isErr()) {
-            return res;
-        }
-
-        // check if we have a ternary expression
-        switch (m_currentToken.type) {
-            case TokenType::QUESTION: {
-                UNWRAP_ADVANCE()
-                auto trueBranch = parseExpression();
-                if (trueBranch.isErr()) {
-                    return trueBranch;
-                }
-
-                CONSUME_TOKEN(TokenType::COLON)
-                auto falseBranch = parseExpression();
-                if (falseBranch.isErr()) {
-                    return falseBranch;
-                }
-
-                return geode::Ok(std::make_unique<TernaryNode>(
-                    std::move(res.unwrap()),
-                    std::move(trueBranch.unwrap()),
-                    std::move(falseBranch.unwrap()),
-                    start, m_currentToken.toIndex
-                ));
-            }
-            case TokenType::NULL_COALESCE: {
-                UNWRAP_ADVANCE()
-                auto trueBranch = parseExpression();
-                if (trueBranch.isErr()) {
-                    return trueBranch;
-                }
-
-                return geode::Ok(std::make_unique<TernaryNode>(
-                    std::move(res.unwrap()),
-                    std::move(trueBranch.unwrap()),
-                    start, m_currentToken.toIndex
-                ));
-            }
-
-            // otherwise, return the boolean expression
-            default: {
-                return res;
-            }
-        }
+        return geode::Ok(m_arena.make<RootNode>(m_arena.copy<Node*>(nodes), 0, m_lexer.m_source.size()));
     }
 
-    ParseResult Parser::parseBooleanExpression() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseComparisonExpression();
-        if (res.isErr()) {
-            return res;
-        }
-
-        switch (m_currentToken.type) {
+    Parser::Precedence Parser::precedenceOf(TokenType type) noexcept {
+        switch (type) {
             case TokenType::AND:
-            case TokenType::OR: {
-                auto op = m_currentToken;
-                UNWRAP_ADVANCE()
-                auto rhs = parseComparisonExpression();
-                if (rhs.isErr()) {
-                    return rhs;
-                }
-
-                return geode::Ok(std::make_unique<BinaryNode>(
-                    std::move(res.unwrap()),
-                    op.type,
-                    std::move(rhs.unwrap()),
-                    start, m_currentToken.toIndex
-                ));
-            }
-
-            default: {
-                return res;
-            }
-        }
-    }
-
-    ParseResult Parser::parseComparisonExpression() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseArithmeticExpression();
-        if (res.isErr()) {
-            return res;
-        }
-
-        switch (m_currentToken.type) {
+            case TokenType::OR:
+                return Precedence::Logical;
             case TokenType::EQUAL_EQUAL:
             case TokenType::NOT_EQUAL:
             case TokenType::LESS:
             case TokenType::GREATER:
             case TokenType::LESS_EQUAL:
-            case TokenType::GREATER_EQUAL: {
-                auto op = m_currentToken;
-                UNWRAP_ADVANCE()
-                auto rhs = parseArithmeticExpression();
-                if (rhs.isErr()) {
-                    return rhs;
-                }
-
-                return geode::Ok(std::make_unique<BinaryNode>(
-                    std::move(res.unwrap()),
-                    op.type,
-                    std::move(rhs.unwrap()),
-                    start, m_currentToken.toIndex
-                ));
-            }
-
-            default: {
-                return res;
-            }
+            case TokenType::GREATER_EQUAL:
+                return Precedence::Comparison;
+            case TokenType::PLUS:
+            case TokenType::MINUS:
+                return Precedence::Additive;
+            case TokenType::STAR:
+            case TokenType::SLASH:
+            case TokenType::PERCENT:
+                return Precedence::Multiplicative;
+            case TokenType::CARET:
+                return Precedence::Power;
+            default:
+                return Precedence::None;
         }
-
     }
 
-    ParseResult Parser::parseArithmeticExpression() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseTerm();
-        if (res.isErr()) {
-            return res;
-        }
-
-        std::stack<std::unique_ptr<Node>> terms;
-        terms.push(std::move(res.unwrap()));
-
-        while (m_currentToken.type == TokenType::PLUS || m_currentToken.type == TokenType::MINUS) {
-            auto type = m_currentToken.type;
-            UNWRAP_ADVANCE()
-            auto rhs = parseTerm();
-            if (rhs.isErr()) {
-                return rhs;
-            }
-
-            auto lhs = std::move(terms.top());
-            terms.pop();
-            terms.push(std::make_unique<BinaryNode>(
-                std::move(lhs),
-                type,
-                std::move(rhs.unwrap()),
-                start, m_currentToken.toIndex
-            ));
-        }
-
-        if (terms.size() == 1) {
-            return geode::Ok(std::move(terms.top()));
+    Parser::Precedence Parser::pendingPrecedence() const noexcept {
+        if (m_operators.size() == m_groups.back().operators) {
+            return Precedence::None;
         }
-
-        return geode::Err(CompileError(
-            std::string(m_lexer.m_source),
-            fmt::format("ParseError: Expected arithmetic expression but found '{}' at index {}", m_currentToken.typeName(), m_currentToken.fromIndex),
-            m_currentToken.fromIndex,
-            m_currentToken.toIndex
-        ));
+        return m_operators.back().precedence;
     }
 
-    ParseResult Parser::parseTerm() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseFactor();
-        if (res.isErr()) {
-            return res;
+    void Parser::reduce() noexcept {
+        // nodes end where the recursive rules used to return, at the token that follows them
+        auto op = m_operators.back();
+        m_operators.pop_back();
+        if (op.prefix) {
+            auto& operand = m_operands.back();
+            operand = { m_arena.make<UnaryNode>(op.type, operand.node, op.start, m_currentToken.toIndex), op.start, operand.depth + 1, false };
+            return;
         }
 
-        std::stack<std::unique_ptr<Node>> terms;
-        terms.push(std::move(res.unwrap()));
-
-        while (m_currentToken.type == TokenType::STAR || m_currentToken.type == TokenType::SLASH || m_currentToken.type == TokenType::PERCENT) {
-            auto type = m_currentToken.type;
-            UNWRAP_ADVANCE()
-            auto rhs = parseFactor();
-            if (rhs.isErr()) {
-                return rhs;
-            }
-
-            auto lhs = std::move(terms.top());
-            terms.pop();
-            terms.push(std::make_unique<BinaryNode>(
-                std::move(lhs),
-                type,
-                std::move(rhs.unwrap()),
-                start, m_currentToken.toIndex
-            ));
-        }
-
-        if (terms.size() == 1) {
-            return geode::Ok(std::move(terms.top()));
-        }
+        auto rhs = m_operands.back();
+        m_operands.pop_back();
+        auto& lhs = m_operands.back();
+        lhs.node = m_arena.make<BinaryNode>(lhs.node, op.type, rhs.node, lhs.start, m_currentToken.toIndex);
+        lhs.depth = std::max(lhs.depth, rhs.depth) + 1;
+        lhs.callable = false;
+    }
 
-        return geode::Err(CompileError(
+    CompileError Parser::nestedTooDeep() const noexcept {
+        return CompileError(
             std::string(m_lexer.m_source),
-            fmt::format("ParseError: Expected term but found '{}' at index {}", m_currentToken.typeName(), m_currentToken.fromIndex),
+            fmt::format("ParseError: Expression nested too deeply at index {}", m_currentToken.fromIndex),
             m_currentToken.fromIndex,
             m_currentToken.toIndex
-        ));
+        );
     }
 
-    ParseResult Parser::parseFactor() noexcept {
-        size_t start = m_currentToken.fromIndex;
-
-        // check for unary operators
-        switch (m_currentToken.type) {
-            case TokenType::PLUS:
-            case TokenType::MINUS:
-            case TokenType::NOT: {
-                auto op = m_currentToken;
-                UNWRAP_ADVANCE()
-                auto res = parseFactor();
-                if (res.isErr()) {
-                    return res;
-                }
-
-                return geode::Ok(std::make_unique<UnaryNode>(
-                    op.type,
-                    std::move(res.unwrap()),
-                    start, m_currentToken.toIndex
-                ));
-            }
-
-            default: break;
-        }
-
-        auto res = parseInterpolation();
-        if (res.isErr()) {
-            return res;
+    void Parser::reduceGroup() noexcept {
+        while (m_operators.size() > m_groups.back().operators) {
+            reduce();
         }
-
-        if (m_currentToken.type == TokenType::CARET) {
-            UNWRAP_ADVANCE()
-            auto rhs = parseFactor();
-            if (rhs.isErr()) {
-                return rhs;
-            }
-
-            return geode::Ok(std::make_unique<BinaryNode>(
-                std::move(res.unwrap()),
-                TokenType::CARET,
-                std::move(rhs.unwrap()),
-                start, m_currentToken.toIndex
-            ));
-        }
-
-        return res;
     }
 
-    ParseResult Parser::parseInterpolation() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        if (m_currentToken.type != TokenType::DOLLAR) {
-            return parseAccessor();
-        }
-
-        UNWRAP_ADVANCE()
-        auto res = parseAccessor();
-        if (res.isErr()) {
-            return res;
-        }
-
-        return geode::Ok(std::make_unique<UnaryNode>(
-            TokenType::DOLLAR,
-            std::move(res.unwrap()),
-            start, m_currentToken.toIndex
-        ));
-    }
+    ParseResult Parser::parseExpression() noexcept {
+        // a failed parse may have left the stacks behind, nothing outlives a single expression
+        m_operands.clear();
+        m_operators.clear();
+        m_groups.clear();
+        m_groups.push_back({ Group::Kind::Expression, 0, 0, 0 });
+
+        enum class State {
+            Operand, // expecting a prefix operator, an atom or an opening parenthesis
+            Postfix, // after an atom, expecting an argument list, a member access or an index
+            Infix,   // after an operand, expecting a binary operator or a ternary
+            End,     // the innermost group has no more tokens
+        } state = State::Operand;
+        bool atomOnly = false; // `$` applies to an accessor chain, which cannot start with an operator
+
+        while (true) {
+            // every new node ends up on top of the operand stack, so checking it once per step sees all of them
+            if (m_groups.size() + m_operators.size() > MAX_DEPTH || (!m_operands.empty() && m_operands.back().depth > MAX_TREE_DEPTH)) {
+                return geode::Err(nestedTooDeep());
+            }
 
-    ParseResult Parser::parseAccessor() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseCall();
-        if (res.isErr()) {
-            return res;
-        }
+            switch (state) {
+                case State::Operand: {
+                    auto type = m_currentToken.type;
+                    if (!atomOnly && (type == TokenType::PLUS || type == TokenType::MINUS || type == TokenType::NOT)) {
+                        m_operators.push_back({ type, Precedence::Prefix, true, m_currentToken.fromIndex });
+                        UNWRAP_ADVANCE()
+                        break;
+                    }
+                    if (!atomOnly && type == TokenType::DOLLAR) {
+                        m_operators.push_back({ type, Precedence::Interpolation, true, m_currentToken.fromIndex });
+                        UNWRAP_ADVANCE()
+                        atomOnly = true;
+                        break;
+                    }
 
-        std::stack<std::unique_ptr<Node>> accessors;
-        accessors.push(std::move(res.unwrap()));
+                    atomOnly = false;
+                    if (type == TokenType::LEFT_PAREN) {
+                        m_groups.push_back({ Group::Kind::Parentheses, m_operators.size(), m_operands.size(), m_currentToken.fromIndex });
+                        UNWRAP_ADVANCE()
+                        break;
+                    }
 
-        while (m_currentToken.type == TokenType::DOT || m_currentToken.type == TokenType::LEFT_BRACKET) {
-            switch (m_currentToken.type) {
-                case TokenType::DOT: {
-                    UNWRAP_NEXT_TOKEN(auto key)
-                    CONSUME_TOKEN(TokenType::IDENTIFIER)
-                    accessors.push(std::make_unique<AccessorNode>(
-                        std::move(accessors.top()),
-                        key.value,
-                        start, m_currentToken.toIndex
-                    ));
+                    size_t start = m_currentToken.fromIndex;
+                    auto atom = parseAtom();
+                    if (atom.isErr()) {
+                        return atom;
+                    }
+                    m_operands.push_back({ atom.unwrap(), start, 1, true });
+                    state = State::Postfix;
                 } break;
 
-                case TokenType::LEFT_BRACKET: {
-                    UNWRAP_ADVANCE()
-                    auto key = parseExpression();
-                    if (key.isErr()) {
-                        return key;
+                case State::Postfix: {
+                    auto& operand = m_operands.back();
+                    switch (m_currentToken.type) {
+                        case TokenType::LEFT_PAREN: {
+                            // only an atom can be called, `a.b(1)` and `f(1)(2)` end the expression
+                            if (!operand.callable) {
+                                state = State::Infix;
+                                break;
+                            }
+                            m_groups.push_back({ Group::Kind::Arguments, m_operators.size(), m_operands.size(), 0 });
+                            UNWRAP_ADVANCE()
+                            state = m_currentToken.type == TokenType::RIGHT_PAREN ? State::End : State::Operand;
+                        } break;
+
+                        case TokenType::DOT: {
+                            UNWRAP_NEXT_TOKEN(auto key)
+                            CONSUME_TOKEN(TokenType::IDENTIFIER)
+                            operand.node = m_arena.make<AccessorNode>(
+                                operand.node,
+                                key.value,
+                                operand.start, m_currentToken.toIndex
+                            );
+                            operand.depth++;
+                            operand.callable = false;
+                        } break;
+
+                        case TokenType::LEFT_BRACKET: {
+                            m_groups.push_back({ Group::Kind::Index, m_operators.size(), m_operands.size(), 0 });
+                            UNWRAP_ADVANCE()
+                            state = State::Operand;
+                        } break;
+
+                        default: {
+                            state = State::Infix;
+                        } break;
                     }
-
-                    CONSUME_TOKEN(TokenType::RIGHT_BRACKET)
-                    accessors.push(std::make_unique<IndexerNode>(
-                        std::move(accessors.top()),
-                        std::move(key.unwrap()),
-                        start, m_currentToken.toIndex
-                    ));
                 } break;
 
-                default: {
-                    break;
-                }
-            }
-        }
-
-        return geode::Ok(std::move(accessors.top()));
-    }
-
-    ParseResult Parser::parseCall() noexcept {
-        size_t start = m_currentToken.fromIndex;
-        auto res = parseAtom();
-        if (res.isErr()) {
-            return res;
-        }
+                case State::Infix: {
+                    auto type = m_currentToken.type;
+                    if (type == TokenType::QUESTION || type == TokenType::NULL_COALESCE) {
+                        // the condition is everything parsed so far in this group
+                        reduceGroup();
+                        auto kind = type == TokenType::QUESTION ? Group::Kind::TrueBranch : Group::Kind::Coalesce;
+                        m_groups.push_back({ kind, m_operators.size(), m_operands.size(), 0 });
+                        UNWRAP_ADVANCE()
+                        state = State::Operand;
+                        break;
+                    }
 
-        if (m_currentToken.type != TokenType::LEFT_PAREN) {
-            return res;
-        }
+                    auto precedence = precedenceOf(type);
+                    if (precedence == Precedence::None) {
+                        state = State::End;
+                        break;
+                    }
 
-        UNWRAP_ADVANCE()
-        std::vector<std::unique_ptr<Node>> args;
-        while (m_currentToken.type != TokenType::RIGHT_PAREN) {
-            auto arg = parseExpression();
-            if (arg.isErr()) {
-                return arg;
-            }
+                    while (pendingPrecedence() > precedence) {
+                        reduce();
+                    }
+                    if (pendingPrecedence() == precedence) {
+                        // comparisons and logical operators do not chain, a second one ends the expression
+                        if (precedence == Precedence::Comparison || precedence == Precedence::Logical) {
+                            state = State::End;
+                            break;
+                        }
+                        // fold left to right, except for ^ which is right-associative
+                        if (precedence != Precedence::Power) {
+                            reduce();
+                        }
+                    }
 
-            args.push_back(std::move(arg.unwrap()));
+                    m_operators.push_back({ type, precedence, false, 0 });
+                    UNWRAP_ADVANCE()
+                    state = State::Operand;
+                } break;
 
-            if (m_currentToken.type != TokenType::COMMA) {
-                break;
+                case State::End: {
+                    reduceGroup();
+                    auto group = m_groups.back();
+                    m_groups.pop_back();
+
+                    switch (group.kind) {
+                        case Group::Kind::Expression: {
+                            auto result = m_operands.back();
+                            m_operands.pop_back();
+                            if (result.depth > MAX_TREE_DEPTH) {
+                                return geode::Err(nestedTooDeep());
+                            }
+                            return geode::Ok(result.node);
+                        }
+
+                        case Group::Kind::Parentheses: {
+                            CONSUME_TOKEN(TokenType::RIGHT_PAREN)
+                            // a parenthesized expression is an atom, so it can be called
+                            auto& operand = m_operands.back();
+                            operand.start = group.start;
+                            operand.callable = true;
+                            state = State::Postfix;
+                        } break;
+
+                        case Group::Kind::Index: {
+                            CONSUME_TOKEN(TokenType::RIGHT_BRACKET)
+                            auto index = m_operands.back();
+                            m_operands.pop_back();
+                            auto& operand = m_operands.back();
+                            operand.node = m_arena.make<IndexerNode>(
+                                operand.node,
+                                index.node,
+                                operand.start, m_currentToken.toIndex
+                            );
+                            operand.depth = std::max(operand.depth, index.depth) + 1;
+                            operand.callable = false;
+                            state = State::Postfix;
+                        } break;
+
+                        case Group::Kind::Arguments: {
+                            // a comma starts the next argument, unless it is a trailing one
+                            if (m_currentToken.type == TokenType::COMMA) {
+                                UNWRAP_ADVANCE()
+                                if (m_currentToken.type != TokenType::RIGHT_PAREN) {
+                                    m_groups.push_back(group);
+                                    state = State::Operand;
+                                    break;
+                                }
+                            }
+                            CONSUME_TOKEN(TokenType::RIGHT_PAREN)
+
+                            std::span<Node*> args;
+                            size_t depth = m_operands[group.operands - 1].depth;
+                            if (auto count = m_operands.size() - group.operands; count > 0) {
+                                auto* data = static_cast<Node**>(m_arena.allocate(count * sizeof(Node*), alignof(Node*)));
+                                for (size_t i = 0; i < count; ++i) {
+                                    data[i] = m_operands[group.operands + i].node;
+                                    depth = std::max(depth, m_operands[group.operands + i].depth);
+                                }
+                                args = { data, count };
+                            }
+                            m_operands.resize(group.operands);
+
+                            auto& callee = m_operands.back();
+                            callee.node = m_arena.make<CallNode>(callee.node, args, callee.start, m_currentToken.toIndex);
+                            callee.depth = depth + 1;
+                            callee.callable = false;
+                            state = State::Postfix;
+                        } break;
+
+                        case Group::Kind::TrueBranch: {
+                            CONSUME_TOKEN(TokenType::COLON)
+                            m_groups.push_back({ Group::Kind::FalseBranch, m_operators.size(), m_operands.size(), 0 });
+                            state = State::Operand;
+                        } break;
+
+                        case Group::Kind::FalseBranch: {
+                            auto falseBranch = m_operands.back();
+                            m_operands.pop_back();
+                            auto trueBranch = m_operands.back();
+                            m_operands.pop_back();
+                            auto& condition = m_operands.back();
+                            condition.node = m_arena.make<TernaryNode>(
+                                condition.node,
+                                trueBranch.node,
+                                falseBranch.node,
+                                condition.start, m_currentToken.toIndex
+                            );
+                            condition.depth = std::max({ condition.depth, trueBranch.depth, falseBranch.depth }) + 1;
+                            // a ternary spans the rest of its expression, so the enclosing group ends as well
+                            state = State::End;
+                        } break;
+
+                        case Group::Kind::Coalesce: {
+                            auto trueBranch = m_operands.back();
+                            m_operands.pop_back();
+                            auto& condition = m_operands.back();
+                            condition.node = m_arena.make<TernaryNode>(
+                                condition.node,
+                                trueBranch.node,
+                                condition.start, m_currentToken.toIndex
+                            );
+                            condition.depth = std::max(condition.depth, trueBranch.depth) + 1;
+                            state = State::End;
+                        } break;
+                    }
+                } break;
             }
-
-            UNWRAP_ADVANCE()
         }
-        CONSUME_TOKEN(TokenType::RIGHT_PAREN)
-
-        return geode::Ok(std::make_unique<CallNode>(
-            std::move(res.unwrap()),
-            std::move(args),
-            start, m_currentToken.toIndex
-        ));
     }
 
     ParseResult Parser::parseAtom() noexcept {
@@ -475,17 +455,18 @@ namespace rift {
             case TokenType::IDENTIFIER: {
                 auto name = m_currentToken;
                 UNWRAP_ADVANCE()
-                return geode::Ok(std::make_unique<IdentifierNode>(name));
+                auto slot = m_schema ? m_schema->slot(name.value) : VariableSchema::NO_SLOT;
+                return geode::Ok(m_arena.make<IdentifierNode>(name.value, name.fromIndex, name.toIndex, slot));
             }
 
             case TokenType::STRING: {
-                auto node = std::make_unique<ValueNode>(
-                    Value(m_currentToken.value),
+                auto node = m_arena.make<ValueNode>(
+                    Value(text(m_currentToken)),
                     m_currentToken.fromIndex,
                     m_currentToken.toIndex
                 );
                 UNWRAP_ADVANCE()
-                return geode::Ok(std::move(node));
+                return geode::Ok(node);
             }
 
             case TokenType::INTEGER: {
@@ -498,13 +479,13 @@ namespace rift {
                         m_currentToken.toIndex
                     ));
                 }
-                auto node = std::make_unique<ValueNode>(
+                auto node = m_arena.make<ValueNode>(
                     Value(number.unwrap()),
                     m_currentToken.fromIndex,
                     m_currentToken.toIndex
                 );
                 UNWRAP_ADVANCE()
-                return geode::Ok(std::move(node));
+                return geode::Ok(node);
             }
 
             case TokenType::FLOAT: {
@@ -517,24 +498,13 @@ namespace rift {
                         m_currentToken.toIndex
                     ));
                 }
-                auto node = std::make_unique<ValueNode>(
+                auto node = m_arena.make<ValueNode>(
                     Value(number.unwrap()),
                     m_currentToken.fromIndex,
                     m_currentToken.toIndex
                 );
                 UNWRAP_ADVANCE()
-                return geode::Ok(std::move(node));
-            }
-
-            case TokenType::LEFT_PAREN: {
-                UNWRAP_ADVANCE()
-                auto res = parseExpression();
-                if (res.isErr()) {
-                    return res;
-                }
-
-                CONSUME_TOKEN(TokenType::RIGHT_PAREN)
-                return res;
+                return geode::Ok(node);
             }
 
             default: {
@@ -1,20 +1,100 @@
 #include <rift.hpp>
 
+#include <rift/inference.hpp>
 #include <rift/parser.hpp>
 
+#include <rift/nodes/accessor.hpp>
+#include <rift/nodes/binary.hpp>
+#include <rift/nodes/call.hpp>
+#include <rift/nodes/indexer.hpp>
+#include <rift/nodes/root.hpp>
+#include <rift/nodes/ternary.hpp>
+#include <rift/nodes/unary.hpp>
+
 namespace rift {
 
-    CompileResult compile(std::string_view source, bool directMode) noexcept {
-        Parser parser(Lexer(source, directMode), directMode);
+    /// @brief Binds every named call in the tree to its function.
+    /// @return the first call to a function that is not registered, or nullptr
+    static CallNode const* bindCalls(Node const& node) noexcept {
+        auto firstOf = [](CallNode const* a, CallNode const* b) { return a ? a : b; };
+        switch (node.type()) {
+            case Node::Type::Root: {
+                CallNode const* unbound = nullptr;
+                for (auto const& child : static_cast<RootNode const&>(node).nodes()) {
+                    unbound = firstOf(unbound, bindCalls(*child));
+                }
+                return unbound;
+            }
+            case Node::Type::Binary: {
+                auto const& binary = static_cast<BinaryNode const&>(node);
+                return firstOf(bindCalls(*binary.lhs()), bindCalls(*binary.rhs()));
+            }
+            case Node::Type::Unary:
+                return bindCalls(static_cast<UnaryNode const&>(node).value());
+            case Node::Type::Ternary: {
+                auto const& ternary = static_cast<TernaryNode const&>(node);
+                auto unbound = firstOf(bindCalls(ternary.cond()), bindCalls(ternary.trueBranch()));
+                return ternary.hasFalseBranch() ? firstOf(unbound, bindCalls(ternary.falseBranch())) : unbound;
+            }
+            case Node::Type::Call: {
+                auto const& call = static_cast<CallNode const&>(node);
+                CallNode const* unbound = nullptr;
+                if (auto const* binding = call.binding()) {
+                    unbound = binding->resolve() ? nullptr : &call;
+                } else {
+                    unbound = bindCalls(*call.node());
+                }
+                for (auto const& arg : call.args()) {
+                    unbound = firstOf(unbound, bindCalls(*arg));
+                }
+                return unbound;
+            }
+            case Node::Type::Accessor:
+                return bindCalls(*static_cast<AccessorNode const&>(node).node());
+            case Node::Type::Indexer: {
+                auto const& indexer = static_cast<IndexerNode const&>(node);
+                return firstOf(bindCalls(*indexer.node()), bindCalls(*indexer.index()));
+            }
+            default:
+                return nullptr;
+        }
+    }
+
+    CompileResult compile(std::string_view source, bool directMode, OptimizationLevel level, bool checkFunctions) noexcept {
+        return compile(source, VariableSchema(), directMode, level, checkFunctions);
+    }
+
+    CompileResult compile(
+        std::string_view source, VariableSchema const& schema, bool directMode,
+        OptimizationLevel level, bool checkFunctions
+    ) noexcept {
+        // the tree points into the source, so the script keeps its own copy
+        Arena arena;
+        auto text = arena.copy(source);
+        Parser parser(Lexer(text, directMode), arena, directMode, &schema);
         auto result = parser.parse();
         if (result.isErr()) {
             return geode::Err(result.unwrapErr());
         }
-        return geode::Ok(std::make_unique<Script>(std::move(result.unwrap())));
+
+        auto* root = result.unwrap();
+        auto removedNodes = Optimizer(level, arena).optimize(root);
+        // runs after folding, so the kernels are only picked for what is left to evaluate
+        TypeInference(schema).annotate(*root);
+
+        if (auto const* unbound = bindCalls(*root); unbound && checkFunctions) {
+            return geode::Err(CompileError(
+                std::string(source),
+                fmt::format("BindError: Function '{}' not found", unbound->binding()->name()),
+                unbound->fromIndex(),
+                unbound->toIndex()
+            ));
+        }
+        return geode::Ok(std::make_unique<Script>(std::move(arena), root, removedNodes, schema));
     }
 
     FormatResult format(std::string_view source, Object const& variables) noexcept {
-        auto compileResult = compile(source, false);
+        auto compileResult = ScriptCache::get().compile(source, false);
         if (compileResult.isErr()) {
             return geode::Err(compileResult.unwrapErr());
         }
@@ -33,7 +113,7 @@ namespace rift {
     }
 
     EvaluateResult evaluate(std::string_view source, Object const& variables) noexcept {
-        auto compileResult = compile(source, true);
+        auto compileResult = ScriptCache::get().compile(source, true);
         if (compileResult.isErr()) {
             return geode::Err(compileResult.unwrapErr());
         }
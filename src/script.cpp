@@ -1,23 +1,83 @@
 #include <rift/script.hpp>
+#include <rift/bytecode.hpp>
 #include <rift/visitor.hpp>
 
 namespace rift {
 
+    Script::Script(Arena arena, Node const* root, size_t removedNodes, VariableSchema schema) noexcept
+        : m_arena(std::move(arena)), m_root(root), m_schema(std::move(schema)), m_removedNodes(removedNodes) {}
+
+    Script::~Script() noexcept = default;
+
     RunResult Script::run(Object const &variables) const noexcept {
-        auto result = eval(variables);
+        std::string result;
+        auto res = runInto(result, variables);
+        if (res.isErr()) {
+            return geode::Err(std::move(res.unwrapErr()));
+        }
+        return geode::Ok(std::move(result));
+    }
+
+    RenderResult Script::runInto(std::string& out, Object const& variables) const noexcept {
+        if (m_chunk) {
+            return m_chunk->runInto(out, variables, {}, nullptr, m_precision);
+        }
+
+        out.clear();
+        return Visitor(variables, {}, nullptr, m_precision).render(*m_root, out);
+    }
+
+    EvalResult Script::eval(Object const &variables) const noexcept {
+        auto result = m_chunk
+            ? m_chunk->run(variables, {}, nullptr, m_precision)
+            : Visitor(variables, {}, nullptr, m_precision).visit(*m_root);
         if (result.isErr()) {
             return geode::Err(std::move(result.unwrapErr()));
         }
-        return geode::Ok(std::move(result.unwrap().toString()));
+
+        // the result can outlive the script, so it must not refer to the text in the arena
+        result.unwrap().detach();
+        return geode::Ok(std::move(result.unwrap()));
+    }
+
+    RunResult Script::run(std::span<Value const> frame) const noexcept {
+        std::string result;
+        auto res = runInto(result, frame);
+        if (res.isErr()) {
+            return geode::Err(std::move(res.unwrapErr()));
+        }
+        return geode::Ok(std::move(result));
     }
 
-    EvalResult Script::eval(Object const &variables) const noexcept {
-        Visitor visitor(variables);
-        auto result = visitor.visit(*m_root);
+    RenderResult Script::runInto(std::string& out, std::span<Value const> frame) const noexcept {
+        static Object const noVariables;
+        if (m_chunk) {
+            return m_chunk->runInto(out, noVariables, frame, &m_schema, m_precision);
+        }
+
+        out.clear();
+        return Visitor(noVariables, frame, &m_schema, m_precision).render(*m_root, out);
+    }
+
+    EvalResult Script::eval(std::span<Value const> frame) const noexcept {
+        static Object const noVariables;
+        auto result = m_chunk
+            ? m_chunk->run(noVariables, frame, &m_schema, m_precision)
+            : Visitor(noVariables, frame, &m_schema, m_precision).visit(*m_root);
         if (result.isErr()) {
             return geode::Err(std::move(result.unwrapErr()));
         }
+
+        result.unwrap().detach();
         return geode::Ok(std::move(result.unwrap()));
     }
 
+    void Script::setEngine(Engine engine) noexcept {
+        if (engine == Engine::TreeWalker) {
+            m_chunk.reset();
+        } else if (!m_chunk) {
+            m_chunk = std::make_unique<Chunk>(Chunk::compile(*m_root));
+        }
+    }
+
 }
@@ -3,56 +3,250 @@
 
 #include <fmt/format.h>
 #include <algorithm>
+#include <charconv>
+#include <iterator>
+#include <utility>
 
 namespace rift {
 
-    std::string Value::toString() const noexcept {
+    static void appendInteger(std::string& out, int64_t value) noexcept {
+        char buffer[std::numeric_limits<int64_t>::digits10 + 3];
+        auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value);
+        out.append(buffer, end);
+    }
+
+    static void appendFloat(std::string& out, double value, int precision) noexcept {
+#if defined(__cpp_lib_to_chars)
+        // fixed notation of very large floats can overflow the buffer, those go through fmt instead
+        char buffer[128];
+        auto [end, ec] = std::to_chars(std::begin(buffer), std::end(buffer), value, std::chars_format::fixed, precision);
+        if (ec == std::errc()) {
+            out.append(buffer, end);
+            return;
+        }
+#endif
+        fmt::format_to(std::back_inserter(out), "{:.{}f}", value, precision);
+    }
+
+    std::string Value::toString(int precision) const noexcept {
+        if (m_type == Type::String) {
+            return std::string(getStringView());
+        }
+
+        std::string result;
+        appendTo(result, precision);
+        return result;
+    }
+
+    void Value::appendTo(std::string& out, int precision) const noexcept {
         switch (m_type) {
             case Type::String:
-                return std::get<std::string>(m_data);
+                out += getStringView();
+                break;
             case Type::Integer:
-                return std::to_string(std::get<int64_t>(m_data));
+                appendInteger(out, load<int64_t>());
+                break;
             case Type::Float:
-                return fmt::format("{:.2f}", std::get<double>(m_data));
+                appendFloat(out, load<double>(), precision);
+                break;
             case Type::Boolean:
-                return std::get<bool>(m_data) ? "true" : "false";
+                out += load<bool>() ? "true" : "false";
+                break;
             case Type::Array: {
-                std::string result = "[";
+                out += '[';
                 auto const& array = getArray();
                 for (size_t i = 0; i < array.size(); ++i) {
-                    result += array[i].toString();
-                    if (i + 1 < array.size()) result += ", ";
+                    array[i].appendTo(out, precision);
+                    if (i + 1 < array.size()) out += ", ";
                 }
-                return result + "]";
-            }
+                out += ']';
+            } break;
             case Type::Object: {
                 // print all key-value pairs in the object on separate lines
-                std::string result = "{";
+                out += '{';
+                bool first = true;
                 for (auto const& [key, value] : getObject()) {
-                    result += fmt::format("{}: {}, ", key, value.toString());
+                    if (!first) out += ", ";
+                    first = false;
+                    out += key;
+                    out += ": ";
+                    value.appendTo(out, precision);
                 }
-                if (!result.empty()) result.resize(result.size() - 2);
-                return result + "}";
-            }
+                out += '}';
+            } break;
+            case Type::Native: {
+                // printed like an object, with the current values of its properties
+                out += '{';
+                auto object = load<void const*>();
+                if (auto const* type = getNativeType()) {
+                    bool first = true;
+                    for (auto const& property : type->properties()) {
+                        if (!first) out += ", ";
+                        first = false;
+                        out += property.name;
+                        out += ": ";
+                        property.get(object).appendTo(out, precision);
+                    }
+                }
+                out += '}';
+            } break;
+            case Type::Lazy:
+                resolve().appendTo(out, precision);
+                break;
             default:
-                return "null";
+                out += "null";
+                break;
         }
     }
 
-    int64_t Value::toInteger() const noexcept {
+    void Value::detach() noexcept {
         switch (m_type) {
             case Type::String:
-                return util::readNumber<int64_t>(std::get<std::string>(m_data)).unwrapOrDefault();
+                if (isBorrowed()) {
+                    *this = Value(getStringView());
+                }
+                break;
+            case Type::Array:
+                // avoid cloning a shared array when there is nothing to replace
+                if (hasBorrowed()) {
+                    for (auto& item : mutableArray()) {
+                        item.detach();
+                    }
+                }
+                break;
+            case Type::Object:
+                if (hasBorrowed()) {
+                    for (auto& [key, value] : mutableObject()) {
+                        value.detach();
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    bool Value::hasBorrowed() const noexcept {
+        switch (m_type) {
+            case Type::String:
+                return isBorrowed();
+            case Type::Array:
+                return std::ranges::any_of(getArray(), [](Value const& item) { return item.hasBorrowed(); });
+            case Type::Object:
+                return std::ranges::any_of(getObject(), [](auto const& pair) { return pair.second.hasBorrowed(); });
+            default:
+                return false;
+        }
+    }
+
+    void Value::resolveAll() noexcept {
+        switch (m_type) {
+            case Type::Lazy:
+                // the result may hold lazy values of its own
+                *this = resolve();
+                resolveAll();
+                break;
+            case Type::Array:
+                // avoid cloning a shared array when there is nothing to replace
+                if (hasLazy()) {
+                    for (auto& item : mutableArray()) {
+                        item.resolveAll();
+                    }
+                }
+                break;
+            case Type::Object:
+                if (hasLazy()) {
+                    for (auto& [key, value] : mutableObject()) {
+                        value.resolveAll();
+                    }
+                }
+                break;
+            default:
+                break;
+        }
+    }
+
+    bool Value::hasLazy() const noexcept {
+        switch (m_type) {
+            case Type::Lazy:
+                return true;
+            case Type::Array:
+                return std::ranges::any_of(getArray(), [](Value const& item) { return item.hasLazy(); });
+            case Type::Object:
+                return std::ranges::any_of(getObject(), [](auto const& pair) { return pair.second.hasLazy(); });
+            default:
+                return false;
+        }
+    }
+
+    void Value::release() noexcept {
+        auto* shared = load<detail::RefCounted*>();
+        if (shared->refs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+            return;
+        }
+
+        switch (m_type) {
+            case Type::String:
+                delete static_cast<detail::Shared<std::string>*>(shared);
+                break;
+            case Type::Array:
+                delete static_cast<detail::Shared<Array>*>(shared);
+                break;
+            case Type::Object:
+                delete static_cast<detail::Shared<Object>*>(shared);
+                break;
+            case Type::Lazy:
+                delete static_cast<detail::Shared<Provider>*>(shared);
+                break;
+            default:
+                break;
+        }
+    }
+
+    Array& Value::mutableArray() noexcept {
+        auto* array = static_cast<detail::Shared<Array>*>(load<detail::RefCounted*>());
+        if (array->refs.load(std::memory_order_acquire) > 1) {
+            auto* copy = new detail::Shared<Array>(array->value);
+            release();
+            store<detail::RefCounted*>(copy);
+            array = copy;
+        }
+        return array->value;
+    }
+
+    Object& Value::mutableObject() noexcept {
+        auto* object = static_cast<detail::Shared<Object>*>(load<detail::RefCounted*>());
+        if (object->refs.load(std::memory_order_acquire) > 1) {
+            auto* copy = new detail::Shared<Object>(object->value);
+            release();
+            store<detail::RefCounted*>(copy);
+            object = copy;
+        }
+        return object->value;
+    }
+
+    int64_t Value::toInteger() const noexcept {
+        switch (m_type) {
+            case Type::String: {
+                // fromChars leaves the result alone if the string is not a number
+                int64_t result = 0;
+                (void) util::fromChars(getStringView(), result);
+                return result;
+            }
             case Type::Integer:
-                return std::get<int64_t>(m_data);
+                return load<int64_t>();
             case Type::Float:
-                return static_cast<int64_t>(std::get<double>(m_data));
+                return static_cast<int64_t>(load<double>());
             case Type::Boolean:
-                return std::get<bool>(m_data) ? 1 : 0;
+                return load<bool>() ? 1 : 0;
             case Type::Array:
-                return static_cast<int64_t>(std::get<Array>(m_data).size());
+                return static_cast<int64_t>(getArray().size());
             case Type::Object:
-                return static_cast<int64_t>(std::get<Object>(m_data).size());
+                return static_cast<int64_t>(getObject().size());
+            case Type::Native:
+                return static_cast<int64_t>(nativeSize());
+            case Type::Lazy:
+                return resolve().toInteger();
             default:
                 return 0;
         }
@@ -60,18 +254,25 @@ namespace rift {
 
     double Value::toFloat() const noexcept {
         switch (m_type) {
-            case Type::String:
-                return util::readNumber<double>(std::get<std::string>(m_data)).unwrapOr(std::numeric_limits<double>::quiet_NaN());
+            case Type::String: {
+                double result = std::numeric_limits<double>::quiet_NaN();
+                (void) util::fromChars(getStringView(), result);
+                return result;
+            }
             case Type::Integer:
-                return static_cast<double>(std::get<int64_t>(m_data));
+                return static_cast<double>(load<int64_t>());
             case Type::Float:
-                return std::get<double>(m_data);
+                return load<double>();
             case Type::Boolean:
-                return std::get<bool>(m_data) ? 1.0 : 0.0;
+                return load<bool>() ? 1.0 : 0.0;
             case Type::Array:
-                return static_cast<double>(std::get<Array>(m_data).size());
+                return static_cast<double>(getArray().size());
             case Type::Object:
-                return static_cast<double>(std::get<Object>(m_data).size());
+                return static_cast<double>(getObject().size());
+            case Type::Native:
+                return static_cast<double>(nativeSize());
+            case Type::Lazy:
+                return resolve().toFloat();
             default:
                 return 0.0;
         }
@@ -80,30 +281,37 @@ namespace rift {
     bool Value::toBoolean() const noexcept {
         switch (m_type) {
             case Type::String:
-                return !std::get<std::string>(m_data).empty();
+                return !getStringView().empty();
             case Type::Integer:
-                return std::get<int64_t>(m_data) != 0;
+                return load<int64_t>() != 0;
             case Type::Float:
-                return std::get<double>(m_data) != 0.0;
+                return load<double>() != 0.0;
             case Type::Boolean:
-                return std::get<bool>(m_data);
+                return load<bool>();
             case Type::Array:
-                return !std::get<Array>(m_data).empty();
+                return !getArray().empty();
             case Type::Object:
-                return !std::get<Object>(m_data).empty();
+                return !getObject().empty();
+            case Type::Native:
+                return nativeSize() != 0;
+            case Type::Lazy:
+                return resolve().toBoolean();
             default:
                 return false;
         }
     }
 
-    Value::Result Value::operator+(const Value& other) const noexcept {
+    Value::Result Value::operator+(const Value& other) const& noexcept {
+        // lazy operands are computed first, like the conversions do
+        if (isLazy() || other.isLazy()) return resolve() + other.resolve();
+
         // if either value is null, return null
         if (isNull() || other.isNull()) {
             return geode::Ok(Value());
         }
 
         // if either value is an object, return an error
-        if (isObject() || other.isObject()) {
+        if (hasMembers() || other.hasMembers()) {
             return geode::Err("Cannot perform object addition");
         }
 
@@ -113,14 +321,14 @@ namespace rift {
             if (isArray() && other.isArray()) {
                 auto result = getArray();
                 result.insert(result.end(), other.getArray().begin(), other.getArray().end());
-                return geode::Ok(Value(result));
+                return geode::Ok(Value(std::move(result)));
             }
 
             // if one value is an array, append the other value
             auto const& array = isArray() ? getArray() : other.getArray();
             auto result = array;
             result.push_back(isArray() ? other : *this);
-            return geode::Ok(Value(result));
+            return geode::Ok(Value(std::move(result)));
         }
 
         // if either value is a string, concatenate them
@@ -137,14 +345,48 @@ namespace rift {
         return geode::Ok(Value(toInteger() + other.toInteger()));
     }
 
-    Value::Result Value::operator-(const Value& other) const noexcept {
+    Value::Result Value::operator+(const Value& other) && noexcept {
+        if (&other != this && !other.isNull() && !other.hasMembers() && !other.isLazy()) {
+            // append to the string buffer this value owns
+            if (isString() && !other.isArray()) {
+                if (auto* str = uniqueString()) {
+                    other.appendTo(*str);
+                    return geode::Ok(std::move(*this));
+                }
+
+                // leave room for the rest of the chain, so the next step can append in place
+                std::string result;
+                result.reserve(std::max<size_t>(getStringView().size() * 2, 32));
+                result += getStringView();
+                other.appendTo(result);
+                return geode::Ok(Value(std::move(result)));
+            }
+
+            // arrays are only cloned if someone else still shares them
+            if (isArray()) {
+                auto& array = mutableArray();
+                if (other.isArray()) {
+                    array.insert(array.end(), other.getArray().begin(), other.getArray().end());
+                } else {
+                    array.push_back(other);
+                }
+                return geode::Ok(std::move(*this));
+            }
+        }
+
+        return std::as_const(*this) + other;
+    }
+
+    Value::Result Value::operator-(const Value& other) const& noexcept {
+        if (isLazy() || other.isLazy()) return resolve() - other.resolve();
+
         // if either value is null, return null
         if (isNull() || other.isNull()) {
             return geode::Ok(Value());
         }
 
         // if either value is an object, return an error
-        if (isObject() || other.isObject()) {
+        if (hasMembers() || other.hasMembers()) {
             return geode::Err("Cannot perform object subtraction");
         }
 
@@ -167,19 +409,19 @@ namespace rift {
                 }
             }
 
-            return geode::Ok(Value(result));
+            return geode::Ok(Value(std::move(result)));
         }
 
         // if either value is a string, remove all occurrences of the other value
         if (isString() || other.isString()) {
             // if both values are strings, remove all occurrences of the other string
             if (isString() && other.isString()) {
-                auto result = getString();
-                auto const& str = other.getString();
+                std::string result(getStringView());
+                auto str = other.getStringView();
 
                 // if the value is empty, return the string
                 if (str.empty()) {
-                    return geode::Ok(Value(result));
+                    return geode::Ok(Value(std::move(result)));
                 }
 
                 size_t pos = 0;
@@ -187,7 +429,7 @@ namespace rift {
                     result.erase(pos, str.size());
                 }
 
-                return geode::Ok(Value(result));
+                return geode::Ok(Value(std::move(result)));
             }
 
             // if first value is not a string, return error
@@ -196,7 +438,7 @@ namespace rift {
             }
 
             // subtract the other value from the string
-            auto str = getString();
+            std::string str(getStringView());
             auto const& value = other.toString();
 
             if (value.empty()) {
@@ -220,14 +462,41 @@ namespace rift {
         return geode::Ok(Value(toInteger() - other.toInteger()));
     }
 
-    Value::Result Value::operator*(const Value& other) const noexcept {
+    Value::Result Value::operator-(const Value& other) && noexcept {
+        // remove the occurrences from the string buffer this value owns
+        if (&other != this && isString() && !other.isNull() && !other.hasMembers() && !other.isArray() && !other.isLazy()) {
+            if (auto* str = uniqueString()) {
+                std::string converted;
+                std::string_view value;
+                if (other.isString()) {
+                    value = other.getStringView();
+                } else {
+                    converted = other.toString();
+                    value = converted;
+                }
+                if (!value.empty()) {
+                    size_t pos = 0;
+                    while ((pos = str->find(value, pos)) != std::string::npos) {
+                        str->erase(pos, value.size());
+                    }
+                }
+                return geode::Ok(std::move(*this));
+            }
+        }
+
+        return std::as_const(*this) - other;
+    }
+
+    Value::Result Value::operator*(const Value& other) const& noexcept {
+        if (isLazy() || other.isLazy()) return resolve() * other.resolve();
+
         // if either value is null, return null
         if (isNull() || other.isNull()) {
             return geode::Ok(Value());
         }
 
         // if either value is an object, return an error
-        if (isObject() || other.isObject()) {
+        if (hasMembers() || other.hasMembers()) {
             return geode::Err("Cannot perform object multiplication");
         }
 
@@ -248,7 +517,7 @@ namespace rift {
                 result.insert(result.end(), array.begin(), array.end());
             }
 
-            return geode::Ok(Value(result));
+            return geode::Ok(Value(std::move(result)));
         }
 
         // if either value is a string, repeat it n times, where n is the other value
@@ -258,7 +527,7 @@ namespace rift {
                 return geode::Err("Cannot multiply two strings");
             }
 
-            auto const& str = isString() ? getString() : other.getString();
+            auto const& str = isString() ? getStringView() : other.getStringView();
             auto num = isString() ? other.toInteger() : toInteger();
 
             if (num <= 0) {
@@ -272,7 +541,7 @@ namespace rift {
                 result += str;
             }
 
-            return geode::Ok(Value(result));
+            return geode::Ok(Value(std::move(result)));
         }
 
         // if either value is a float, convert both to floats and multiply
@@ -284,14 +553,37 @@ namespace rift {
         return geode::Ok(Value(toInteger() * other.toInteger()));
     }
 
+    Value::Result Value::operator*(const Value& other) && noexcept {
+        // repeat the string buffer this value owns in place
+        if (&other != this && isString() && !other.isNull() && !other.hasMembers() && !other.isArray() && !other.isString() && !other.isLazy()) {
+            if (auto* str = uniqueString()) {
+                auto num = other.toInteger();
+                if (num <= 0) {
+                    return geode::Ok(Value(""));
+                }
+
+                auto length = str->size();
+                str->reserve(length * static_cast<size_t>(num));
+                for (int64_t i = 1; i < num; ++i) {
+                    str->append(str->data(), length);
+                }
+                return geode::Ok(std::move(*this));
+            }
+        }
+
+        return std::as_const(*this) * other;
+    }
+
     Value::Result Value::operator/(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() / other.resolve();
+
         // if either value is null, return null
         if (isNull() || other.isNull()) {
             return geode::Ok(Value());
         }
 
         // if either value is an object, return an error
-        if (isObject() || other.isObject()) {
+        if (hasMembers() || other.hasMembers()) {
             return geode::Err("Cannot perform object division");
         }
 
@@ -323,13 +615,15 @@ namespace rift {
     }
 
     Value::Result Value::operator%(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() % other.resolve();
+
         // if either value is null, return null
         if (isNull() || other.isNull()) {
             return geode::Ok(Value());
         }
 
         // if either value is an object, return an error
-        if (isObject() || other.isObject()) {
+        if (hasMembers() || other.hasMembers()) {
             return geode::Err("Cannot perform object modulo");
         }
 
@@ -340,7 +634,7 @@ namespace rift {
 
         // if either value is a string, get a substring
         if (isString() || other.isString()) {
-            auto const& str = isString() ? getString() : other.getString();
+            auto const& str = isString() ? getStringView() : other.getStringView();
             auto const& num = isString() ? other.toInteger() : toInteger();
 
             auto start = num < 0 ? str.size() + num : num;
@@ -370,13 +664,15 @@ namespace rift {
     }
 
     Value::Result Value::operator^(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() ^ other.resolve();
+
         // if either value is null, return null
         if (isNull() || other.isNull()) {
             return geode::Ok(Value());
         }
 
         // if either value is an object, return an error
-        if (isObject() || other.isObject()) {
+        if (hasMembers() || other.hasMembers()) {
             return geode::Err("Cannot perform object exponentiation");
         }
 
@@ -400,6 +696,8 @@ namespace rift {
     }
 
     Value Value::operator==(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() == other.resolve();
+
         // if both values are null, return true
         if (isNull() && other.isNull()) {
             return true;
@@ -410,6 +708,11 @@ namespace rift {
             return false;
         }
 
+        // native handles are equal if they refer to the same object
+        if (isNative() || other.isNative()) {
+            return isNative() && other.isNative() && std::memcmp(m_payload, other.m_payload, NATIVE_SIZE) == 0;
+        }
+
         // if both values are objects, compare them
         if (isObject() && other.isObject()) {
             // fast fail if the objects have different sizes
@@ -450,7 +753,7 @@ namespace rift {
 
         // if both values are strings, compare them
         if (isString() && other.isString()) {
-            return getString() == other.getString();
+            return getStringView() == other.getStringView();
         }
 
         // if either value is a float, convert both to floats and compare
@@ -463,6 +766,8 @@ namespace rift {
     }
 
     Value Value::operator!=(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() != other.resolve();
+
         // if both values are null, return false
         if (isNull() && other.isNull()) {
             return false;
@@ -473,6 +778,10 @@ namespace rift {
             return true;
         }
 
+        if (isNative() || other.isNative()) {
+            return !(isNative() && other.isNative() && std::memcmp(m_payload, other.m_payload, NATIVE_SIZE) == 0);
+        }
+
         // if both values are objects, compare them
         if (isObject() && other.isObject()) {
             // fast fail if the objects have different sizes
@@ -513,7 +822,7 @@ namespace rift {
 
         // if both values are strings, compare them
         if (isString() && other.isString()) {
-            return getString() != other.getString();
+            return getStringView() != other.getStringView();
         }
 
         // if either value is a float, convert both to floats and compare
@@ -526,6 +835,8 @@ namespace rift {
     }
 
     Value Value::operator<(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() < other.resolve();
+
         if (isFloat() || other.isFloat()) {
             return toFloat() < other.toFloat();
         }
@@ -533,6 +844,8 @@ namespace rift {
     }
 
     Value Value::operator>(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() > other.resolve();
+
         if (isFloat() || other.isFloat()) {
             return toFloat() > other.toFloat();
         }
@@ -540,6 +853,8 @@ namespace rift {
     }
 
     Value Value::operator<=(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() <= other.resolve();
+
         if (isFloat() || other.isFloat()) {
             return toFloat() <= other.toFloat();
         }
@@ -547,6 +862,8 @@ namespace rift {
     }
 
     Value Value::operator>=(const Value& other) const noexcept {
+        if (isLazy() || other.isLazy()) return resolve() >= other.resolve();
+
         if (isFloat() || other.isFloat()) {
             return toFloat() >= other.toFloat();
         }
@@ -566,8 +883,9 @@ namespace rift {
     }
 
     Value Value::operator-() const noexcept {
+        if (isLazy()) return -resolve();
         if (isFloat()) {
-            return -std::get<double>(m_data);
+            return -load<double>();
         }
         return -toInteger();
     }
@@ -584,7 +902,7 @@ namespace rift {
             }
             case Type::Object: {
                 auto const& object = getObject();
-                auto it = object.find(key.toString());
+                auto it = key.isString() ? object.find(key.getStringView()) : object.find(key.toString());
                 if (it == object.end()) {
                     return {}; // return null if key is not found
                 }
@@ -592,11 +910,17 @@ namespace rift {
             }
             case Type::String: {
                 auto index = key.toInteger();
-                if (index < 0 || index >= static_cast<int64_t>(getString().size())) {
+                if (index < 0 || index >= static_cast<int64_t>(getStringView().size())) {
                     return {}; // return null if index is out of bounds
                 }
-                return std::string(1, getString()[static_cast<size_t>(index)]);
+                return std::string(1, getStringView()[static_cast<size_t>(index)]);
+            }
+            case Type::Native: {
+                auto const* type = getNativeType();
+                return type ? type->at(load<void const*>(), key) : Value();
             }
+            case Type::Lazy:
+                return resolve().at(key);
             default:
                 return {}; // return null for all other types
         }
@@ -607,6 +931,7 @@ namespace rift {
     }
 
     Value Value::operator[](size_t index) const noexcept {
+        if (isLazy()) return resolve()[index];
         if (!isArray()) return {};
         auto const& array = getArray();
         if (index >= array.size()) return {};
@@ -615,11 +940,10 @@ namespace rift {
 
     Value& Value::operator[](size_t index) noexcept {
         if (!isArray()) {
-            m_type = Type::Array;
-            m_data = Array();
+            *this = Value(Array());
         }
 
-        auto& array = std::get<Array>(m_data);
+        auto& array = mutableArray();
         if (index >= array.size()) {
             array.resize(index + 1);
         }
@@ -627,7 +951,12 @@ namespace rift {
         return array[index];
     }
 
-    Value Value::operator[](std::string const& key) const noexcept {
+    Value Value::operator[](std::string_view key) const noexcept {
+        if (isLazy()) return resolve()[key];
+        if (isNative()) {
+            auto const* type = getNativeType();
+            return type ? type->get(load<void const*>(), key) : Value();
+        }
         if (!isObject()) return {};
         auto const& object = getObject();
         auto it = object.find(key);
@@ -635,13 +964,12 @@ namespace rift {
         return it->second;
     }
 
-    Value& Value::operator[](std::string const &key) noexcept {
+    Value& Value::operator[](std::string_view key) noexcept {
         if (!isObject()) {
-            m_type = Type::Object;
-            m_data = Object();
+            *this = Value(Object());
         }
 
-        auto& object = std::get<Object>(m_data);
+        auto& object = mutableObject();
         return object[key];
     }
 }
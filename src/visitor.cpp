@@ -4,22 +4,32 @@
 #include <rift/nodes/segment.hpp>
 #include <rift/nodes/value.hpp>
 
+#include <optional>
+
 namespace rift {
 
     VisitorResult Visitor::visit(Node const& node) const noexcept {
         switch (node.type()) {
             case Node::Type::Segment:
-                return geode::Ok(static_cast<SegmentNode const&>(node).value());
+                // static text lives in the script arena, so it can be handed out without a copy
+                return geode::Ok(Value::borrowed(static_cast<SegmentNode const&>(node).value()));
             case Node::Type::Root:
                 return visit(static_cast<RootNode const&>(node));
             case Node::Type::Identifier:
                 return visit(static_cast<IdentifierNode const&>(node));
-            case Node::Type::Value:
-                return geode::Ok(static_cast<ValueNode const&>(node).value());
+            case Node::Type::Value: {
+                auto const& value = static_cast<ValueNode const&>(node).value();
+                if (value.isString()) {
+                    return geode::Ok(Value::borrowed(value.getStringView()));
+                }
+                return geode::Ok(value);
+            }
             case Node::Type::Indexer:
                 return visit(static_cast<IndexerNode const&>(node));
             case Node::Type::Accessor:
                 return visit(static_cast<AccessorNode const&>(node));
+            case Node::Type::Path:
+                return visit(static_cast<PathNode const&>(node));
             case Node::Type::Binary:
                 return visit(static_cast<BinaryNode const&>(node));
             case Node::Type::Call:
@@ -35,51 +45,233 @@ namespace rift {
 
     VisitorResult Visitor::visit(RootNode const& node) const noexcept {
         std::string result;
-        for (auto const& child : node.nodes()) {
-            auto res = visit(*child);
-            if (res.isErr()) {
-                return res;
-            }
+        auto res = render(node, result);
+        if (res.isErr()) {
+            return geode::Err(std::move(res.unwrapErr()));
+        }
+        return geode::Ok(Value(std::move(result)));
+    }
 
-            result += res.unwrap().toString();
+    RenderResult Visitor::render(Node const& node, std::string& out) const noexcept {
+        switch (node.type()) {
+            case Node::Type::Root: {
+                for (auto const* child : static_cast<RootNode const&>(node).nodes()) {
+                    auto res = render(*child, out);
+                    if (res.isErr()) {
+                        return res;
+                    }
+                }
+            } break;
+            case Node::Type::Segment:
+                out += static_cast<SegmentNode const&>(node).value();
+                break;
+            case Node::Type::Value:
+                static_cast<ValueNode const&>(node).value().appendTo(out, m_precision);
+                break;
+            case Node::Type::Identifier:
+            case Node::Type::Accessor:
+            case Node::Type::Indexer:
+            case Node::Type::Path: {
+                // skip copying the variable just to print it
+                Value temporary;
+                auto res = reference(node, temporary);
+                if (res.isErr()) {
+                    return geode::Err(std::move(res.unwrapErr()));
+                }
+                res.unwrap()->appendTo(out, m_precision);
+            } break;
+            default: {
+                auto res = visit(node);
+                if (res.isErr()) {
+                    return geode::Err(std::move(res.unwrapErr()));
+                }
+                res.unwrap().appendTo(out, m_precision);
+            } break;
         }
-        return geode::Ok(Value(result));
+        return geode::Ok();
     }
 
     VisitorResult Visitor::visit(IdentifierNode const& node) const noexcept {
+        return geode::Ok(lookup(node));
+    }
+
+    static Value const NULL_VALUE;
+
+    Value const& Visitor::lookup(IdentifierNode const& node) const noexcept {
+        return m_lazyValues->resolve(find(node));
+    }
+
+    Value const& Visitor::find(IdentifierNode const& node) const noexcept {
+        // identifiers resolved at compile time are a plain index into the frame
+        if (node.slot() < m_frame.size()) {
+            return m_frame[node.slot()];
+        }
+
         // find the variable in the object
-        if (auto it = m_variables.get().find(node.name()); it != m_variables.get().end()) {
-            return geode::Ok(it->second);
+        if (auto it = m_variables.get().find(node.name(), node.hash()); it != m_variables.get().end()) {
+            return it->second;
+        }
+
+        // sub-templates are compiled without the schema, so resolve the slot by name
+        if (m_schema) {
+            if (auto slot = m_schema->slot(node.name()); slot < m_frame.size()) {
+                return m_frame[slot];
+            }
         }
 
         // find the variable in the builtins
         auto const& builtins = Config::get().globals();
-        if (auto it = builtins.find(node.name()); it != builtins.end()) {
-            return geode::Ok(it->second);
+        if (auto it = builtins.find(node.name(), node.hash()); it != builtins.end()) {
+            return it->second;
         }
 
         // return null if the variable is not found
-        return geode::Ok(Value());
+        return NULL_VALUE;
+    }
+
+    ReferenceResult Visitor::reference(Node const& node, Value& temporary) const noexcept {
+        switch (node.type()) {
+            case Node::Type::Identifier:
+                return geode::Ok(&lookup(static_cast<IdentifierNode const&>(node)));
+            case Node::Type::Accessor: {
+                auto const& accessor = static_cast<AccessorNode const&>(node);
+                auto obj = reference(*accessor.node(), temporary);
+                if (obj.isErr()) {
+                    return obj;
+                }
+                if (obj.unwrap()->isNative()) {
+                    // properties of host objects are read on demand, they do not exist as values
+                    auto member = (*obj.unwrap())[accessor.name()];
+                    temporary = std::move(member);
+                    return geode::Ok(&m_lazyValues->resolve(temporary));
+                }
+                if (!obj.unwrap()->isObject()) {
+                    return geode::Ok(&NULL_VALUE);
+                }
+
+                auto const& object = obj.unwrap()->getObject();
+                auto it = object.find(accessor.name(), accessor.hash());
+                if (it == object.end()) {
+                    return geode::Ok(&NULL_VALUE);
+                }
+
+                // lazy members are computed once per evaluation, like lazy variables
+                auto const& member = m_lazyValues->resolve(it->second);
+
+                // the member may live inside the temporary itself, copy it out before overwriting the temporary
+                if (obj.unwrap() == &temporary) {
+                    temporary = Value(member);
+                    return geode::Ok(&temporary);
+                }
+                return geode::Ok(&member);
+            }
+            case Node::Type::Path: {
+                auto const& path = static_cast<PathNode const&>(node);
+                return geode::Ok(follow(path, lookup(path.root()), temporary, *m_lazyValues));
+            }
+            case Node::Type::Indexer: {
+                auto const& indexer = static_cast<IndexerNode const&>(node);
+                auto obj = reference(*indexer.node(), temporary);
+                if (obj.isErr()) {
+                    return obj;
+                }
+
+                auto key = visit(*indexer.index());
+                if (key.isErr()) {
+                    return geode::Err(std::move(key.unwrapErr()));
+                }
+
+                Value const* element = &NULL_VALUE;
+                auto const& container = *obj.unwrap();
+                if (container.isArray()) {
+                    auto const& array = container.getArray();
+                    auto index = key.unwrap().toInteger();
+                    if (index >= 0 && index < static_cast<int64_t>(array.size())) {
+                        element = &array[static_cast<size_t>(index)];
+                    }
+                } else if (container.isObject()) {
+                    auto const& object = container.getObject();
+                    auto it = key.unwrap().isString()
+                        ? object.find(key.unwrap().getStringView())
+                        : object.find(key.unwrap().toString());
+                    if (it != object.end()) {
+                        element = &it->second;
+                    }
+                } else {
+                    // characters of a string do not exist as values yet
+                    temporary = container.at(key.unwrap());
+                    return geode::Ok(&m_lazyValues->resolve(temporary));
+                }
+
+                element = &m_lazyValues->resolve(*element);
+                if (&container == &temporary && element != &NULL_VALUE) {
+                    temporary = Value(*element);
+                    return geode::Ok(&temporary);
+                }
+                return geode::Ok(element);
+            }
+            default: {
+                auto res = visit(node);
+                if (res.isErr()) {
+                    return geode::Err(std::move(res.unwrapErr()));
+                }
+                temporary = std::move(res.unwrap());
+                return geode::Ok(&temporary);
+            }
+        }
     }
 
     VisitorResult Visitor::visit(BinaryNode const& node) const noexcept {
-        auto lhs = visit(*node.lhs());
+        // logical operators skip the right side once the left side decides the result
+        if (node.op() == TokenType::AND || node.op() == TokenType::OR) {
+            Value temporary;
+            auto lhs = reference(*node.lhs(), temporary);
+            if (lhs.isErr()) {
+                return geode::Err(std::move(lhs.unwrapErr()));
+            }
+
+            bool decided = node.op() == TokenType::OR;
+            if (lhs.unwrap()->toBoolean() == decided) {
+                return geode::Ok(Value(decided));
+            }
+
+            auto rhs = reference(*node.rhs(), temporary);
+            if (rhs.isErr()) {
+                return geode::Err(std::move(rhs.unwrapErr()));
+            }
+            return geode::Ok(Value(rhs.unwrap()->toBoolean()));
+        }
+
+        // operands are only read, so variables on either side are used in place
+        Value lhsTemporary;
+        auto lhs = reference(*node.lhs(), lhsTemporary);
         if (lhs.isErr()) {
-            return lhs;
+            return geode::Err(std::move(lhs.unwrapErr()));
         }
 
-        auto rhs = visit(*node.rhs());
+        Value rhsTemporary;
+        auto rhs = reference(*node.rhs(), rhsTemporary);
         if (rhs.isErr()) {
-            return rhs;
+            return geode::Err(std::move(rhs.unwrapErr()));
+        }
+
+        if (node.kernel() != Kernel::Generic) {
+            Value result;
+            if (applyKernel(node.kernel(), node.op(), *lhs.unwrap(), *rhs.unwrap(), result)) {
+                return geode::Ok(std::move(result));
+            }
         }
 
 #define CASE(Type, op) \
     case TokenType::Type: { \
-        return geode::Ok(lhs.unwrap() op rhs.unwrap()); \
+        return geode::Ok(*lhs.unwrap() op *rhs.unwrap()); \
     }
+// a left operand this node produced itself is handed over, so concatenation chains append in place
 #define CASE_UNWRAP(Type, op) \
     case TokenType::Type: { \
-        auto res = lhs.unwrap() op rhs.unwrap(); \
+        auto res = lhs.unwrap() == &lhsTemporary \
+            ? std::move(lhsTemporary) op *rhs.unwrap() \
+            : *lhs.unwrap() op *rhs.unwrap(); \
         if (res.isErr()) { \
             return node.error(fmt::format("RuntimeError: {}", res.unwrapErr())); \
         } \
@@ -104,10 +296,6 @@ namespace rift {
             CASE(LESS_EQUAL, <=)
             CASE(GREATER_EQUAL, >=)
 
-            // Logical operators
-            CASE(AND, &&)
-            CASE(OR, ||)
-
             default:
                 return node.error("RuntimeError: Unknown binary operator");
         }
@@ -127,25 +315,54 @@ namespace rift {
             case TokenType::NOT:
                 return geode::Ok(!res.unwrap());
             case TokenType::DOLLAR: {
-                auto val = res.unwrap().toString();
-                auto fmtRes = rift::format(val, m_variables);
-                if (fmtRes.isErr()) {
-                    return node.error(fmt::format("SubExpressionError: {}", fmtRes.unwrapErr().message()));
+                auto str = interpolate(res.unwrap().toString());
+                if (str.isErr()) {
+                    return node.error(std::move(str.unwrapErr()));
                 }
-                return geode::Ok(Value(fmtRes.unwrap()));
+                return geode::Ok(std::move(str.unwrap()));
             }
             default:
                 return node.error("RuntimeError: Unknown unary operator");
         }
     }
 
+    geode::Result<Value> Visitor::interpolate(std::string const& source) const noexcept {
+        // walk the chain of enclosing sub-templates, rendering the same source again would never terminate
+        size_t depth = 1;
+        for (auto const* frame = this; frame->m_parent; frame = frame->m_parent) {
+            if (frame->m_source == source) {
+                return geode::Err(fmt::format("SubExpressionError: Recursive interpolation of '{}'", source));
+            }
+            depth++;
+        }
+
+        if (depth > MAX_INTERPOLATION_DEPTH) {
+            return geode::Err(fmt::format("SubExpressionError: Interpolation depth limit ({}) exceeded", MAX_INTERPOLATION_DEPTH));
+        }
+
+        auto script = ScriptCache::get().compile(source, false);
+        if (script.isErr()) {
+            return geode::Err(fmt::format("SubExpressionError: {}", script.unwrapErr().message()));
+        }
+
+        Visitor visitor(*this, source);
+        std::string result;
+        auto res = visitor.render(script.unwrap()->root(), result);
+        if (res.isErr()) {
+            return geode::Err(fmt::format("SubExpressionError: {}", res.unwrapErr().message()));
+        }
+
+        return geode::Ok(Value(std::move(result)));
+    }
+
     VisitorResult Visitor::visit(TernaryNode const& node) const noexcept {
-        auto condition = visit(node.cond());
+        Value temporary;
+        auto condition = reference(node.cond(), temporary);
         if (condition.isErr()) {
-            return condition;
+            return geode::Err(std::move(condition.unwrapErr()));
         }
 
-        if (condition.unwrap().toBoolean()) {
+        if (condition.unwrap()->toBoolean()) {
             return visit(node.trueBranch());
         }
 
@@ -157,30 +374,59 @@ namespace rift {
     }
 
     VisitorResult Visitor::visit(CallNode const& node) const noexcept {
-        std::string name;
-        if (node.node()->type() == Node::Type::Identifier) {
-            name = static_cast<IdentifierNode const&>(*node.node()).name();
+        RuntimeFunction const* runtimeFunc;
+        LazyParameters lazy;
+        if (auto const* binding = node.binding()) {
+            runtimeFunc = binding->resolve();
+            if (!runtimeFunc) {
+                return node.error(fmt::format("RuntimeError: Function '{}' not found", binding->name()));
+            }
+            lazy = binding->lazyParameters();
         } else {
             auto func = visit(*node.node());
             if (func.isErr()) {
                 return func;
             }
-            name = func.unwrap().toString();
+            auto name = func.unwrap().toString();
+            runtimeFunc = Config::get().getFunction(name);
+            if (!runtimeFunc) {
+                return node.error(fmt::format("RuntimeError: Function '{}' not found", name));
+            }
+            lazy = Config::get().lazyParameters(name);
         }
 
-        auto const* runtimeFunc = Config::get().getFunction(name);
-        if (!runtimeFunc) {
-            return node.error(fmt::format("RuntimeError: Function '{}' not found", name));
-        }
+        // lazy arguments cannot fail the call themselves, the first error they hit is reported after it
+        std::optional<RuntimeError> lazyError;
+        bool lazyArguments = false;
 
         auto args = std::vector<Value>{};
         args.reserve(node.numArgs());
-        for (auto const& arg : node.args()) {
-            auto res = visit(*arg);
+        for (size_t i = 0; i < node.numArgs(); ++i) {
+            auto const* arg = node.args()[i];
+            if (isLazyParameter(lazy, i)) {
+                // the argument is evaluated on the first read, later reads reuse the result
+                args.push_back(Value::lazy([this, arg, &lazyError, result = std::optional<Value>()]() mutable {
+                    if (!result) {
+                        auto res = visit(*arg);
+                        if (res.isErr()) {
+                            if (!lazyError) lazyError = std::move(res.unwrapErr());
+                            result = Value();
+                        } else {
+                            result = std::move(res.unwrap());
+                        }
+                    }
+                    return *result;
+                }));
+                lazyArguments = true;
+                continue;
+            }
+
+            Value temporary;
+            auto res = reference(*arg, temporary);
             if (res.isErr()) {
-                return res;
+                return geode::Err(std::move(res.unwrapErr()));
             }
-            args.push_back(res.unwrap());
+            args.push_back(res.unwrap() == &temporary ? std::move(temporary) : *res.unwrap());
         }
 
         auto res = (*runtimeFunc)(args);
@@ -188,28 +434,96 @@ namespace rift {
             return node.error(fmt::format("RuntimeError: {}", res.unwrapErr()));
         }
 
-        return geode::Ok(res.unwrap());
+        // lazy arguments handed back, as is or inside a container, have to be evaluated before the call frame goes away
+        auto result = std::move(res.unwrap());
+        if (lazyArguments) {
+            result.resolveAll();
+        } else if (result.isLazy()) {
+            result = result.resolve();
+        }
+        if (lazyError) {
+            return geode::Err(std::move(*lazyError));
+        }
+        return geode::Ok(std::move(result));
     }
 
     VisitorResult Visitor::visit(AccessorNode const& node) const noexcept {
-        auto obj = visit(*node.node());
-        if (obj.isErr()) {
-            return obj;
+        // walk the whole chain by reference and copy only the value at the end of it
+        Value temporary;
+        auto res = reference(node, temporary);
+        if (res.isErr()) {
+            return geode::Err(std::move(res.unwrapErr()));
         }
-        return geode::Ok(std::move(obj.unwrap()[node.name()]));
+        if (res.unwrap() == &temporary) {
+            return geode::Ok(std::move(temporary));
+        }
+        return geode::Ok(*res.unwrap());
     }
 
-    VisitorResult Visitor::visit(IndexerNode const& node) const noexcept {
-        auto obj = visit(*node.node());
-        if (obj.isErr()) {
-            return obj;
+    Value const* Visitor::follow(PathNode const& path, Value const& root, Value& temporary, detail::LazyCache& lazyValues) noexcept {
+        Value const* current = &root;
+        for (auto const& step : path.steps()) {
+            Value const* next = &NULL_VALUE;
+            if (step.kind == PathStep::Kind::Member) {
+                if (current->isNative()) {
+                    // the getter reads the host object, which the temporary does not own
+                    auto member = (*current)[step.name];
+                    temporary = std::move(member);
+                    current = &lazyValues.resolve(temporary);
+                    continue;
+                }
+                if (current->isObject()) {
+                    auto const& object = current->getObject();
+                    if (auto it = object.find(step.name, step.hash); it != object.end()) {
+                        next = &it->second;
+                    }
+                }
+            } else if (current->isArray()) {
+                auto const& array = current->getArray();
+                if (step.index >= 0 && step.index < static_cast<int64_t>(array.size())) {
+                    next = &array[static_cast<size_t>(step.index)];
+                }
+            } else if (current->isObject()) {
+                auto const& object = current->getObject();
+                if (auto it = object.find(step.name, step.hash); it != object.end()) {
+                    next = &it->second;
+                }
+            } else {
+                auto element = current->at(*step.key);
+                temporary = std::move(element);
+                current = &lazyValues.resolve(temporary);
+                continue;
+            }
+
+            // the element may live inside the temporary itself, copy it out before overwriting the temporary
+            if (current == &temporary && next != &NULL_VALUE) {
+                temporary = Value(*next);
+                next = &temporary;
+            }
+            // a lazy member has to be computed before the next step can look into it
+            current = &lazyValues.resolve(*next);
         }
+        return current;
+    }
 
-        auto key = visit(*node.index());
-        if (key.isErr()) {
-            return key;
+    VisitorResult Visitor::visit(PathNode const& node) const noexcept {
+        Value temporary;
+        auto const* value = follow(node, lookup(node.root()), temporary, *m_lazyValues);
+        if (value == &temporary) {
+            return geode::Ok(std::move(temporary));
         }
+        return geode::Ok(*value);
+    }
 
-        return geode::Ok(obj.unwrap().at(key.unwrap()));
+    VisitorResult Visitor::visit(IndexerNode const& node) const noexcept {
+        Value temporary;
+        auto res = reference(node, temporary);
+        if (res.isErr()) {
+            return geode::Err(std::move(res.unwrapErr()));
+        }
+        if (res.unwrap() == &temporary) {
+            return geode::Ok(std::move(temporary));
+        }
+        return geode::Ok(*res.unwrap());
     }
 }
@@ -1,4 +1,5 @@
 #include <rift.hpp>
+#include <rift/visitor.hpp>
 #include <fmt/format.h>
 
 #include "fmt/color.h"
@@ -7,23 +8,26 @@ static size_t TEST_COUNT = 0;
 static size_t TEST_FAILED = 0;
 static size_t TEST_PASSED = 0;
 
-void RIFT_EVAL(std::string_view code, rift::Value const& expected, rift::Object const& vars = {}, bool directMode = true) {
+constexpr std::string_view ENGINE_NAMES[] = { "tree", "bytecode" };
+
+void RIFT_EVAL_ENGINE(std::string_view code, rift::Value const& expected, rift::Object const& vars, bool directMode, rift::Script::Engine engine) {
     TEST_COUNT++;
     auto res = rift::compile(code, directMode);
     if (!res) {
         TEST_FAILED++;
         fmt::print(fmt::fg(fmt::color::orange_red), "Test failed: ");
-        fmt::print(fmt::fg(fmt::color::yellow), "'{}'", code);
+        fmt::print(fmt::fg(fmt::color::yellow), "'{}' [{}]", code, ENGINE_NAMES[static_cast<size_t>(engine)]);
         fmt::print(fmt::fg(fmt::color::white), " -> ");
         fmt::print(fmt::fg(fmt::color::orange_red), "{}\n", res.unwrapErr().prettyPrint());
         return;
     }
 
+    res.unwrap()->setEngine(engine);
     auto result = res.unwrap()->eval(vars);
     if (result.isErr()) {
         TEST_FAILED++;
         fmt::print(fmt::fg(fmt::color::orange_red), "Test failed: ");
-        fmt::print(fmt::fg(fmt::color::yellow), "'{}'", code);
+        fmt::print(fmt::fg(fmt::color::yellow), "'{}' [{}]", code, ENGINE_NAMES[static_cast<size_t>(engine)]);
         fmt::print(fmt::fg(fmt::color::white), " -> ");
         fmt::print(fmt::fg(fmt::color::orange_red), "{}\n", result.unwrapErr().prettyPrint(code));
         return;
@@ -39,27 +43,68 @@ void RIFT_EVAL(std::string_view code, rift::Value const& expected, rift::Object
     if (passed) {
         TEST_PASSED++;
         fmt::print(fmt::fg(fmt::color::lime), "Test passed: ");
-        fmt::print(fmt::fg(fmt::color::yellow), "'{}'", code);
+        fmt::print(fmt::fg(fmt::color::yellow), "'{}' [{}]", code, ENGINE_NAMES[static_cast<size_t>(engine)]);
         fmt::print(fmt::fg(fmt::color::white), " -> ");
         fmt::print(fmt::fg(fmt::color::cornflower_blue), "'{}'\n", result.unwrap().toString());
     } else {
         TEST_FAILED++;
         fmt::print(fmt::fg(fmt::color::orange_red), "Test failed: ");
-        fmt::print(fmt::fg(fmt::color::yellow), "'{}'", code);
+        fmt::print(fmt::fg(fmt::color::yellow), "'{}' [{}]", code, ENGINE_NAMES[static_cast<size_t>(engine)]);
         fmt::print(fmt::fg(fmt::color::white), " -> ");
         fmt::print(fmt::fg(fmt::color::cornflower_blue), "'{}'", result.unwrap().toString());
         fmt::print(fmt::fg(fmt::color::orange_red), " (expected: '{}')\n", expected.toString());
     }
 }
 
+void RIFT_EVAL(std::string_view code, rift::Value const& expected, rift::Object const& vars = {}, bool directMode = true) {
+    RIFT_EVAL_ENGINE(code, expected, vars, directMode, rift::Script::Engine::TreeWalker);
+    RIFT_EVAL_ENGINE(code, expected, vars, directMode, rift::Script::Engine::Bytecode);
+}
+
 void RIFT_TEST(std::string_view code, std::string_view expected, rift::Object const& vars = {}) {
     RIFT_EVAL(code, expected, vars, false);
 }
 
+void RIFT_CHECK(std::string_view name, bool condition) {
+    TEST_COUNT++;
+    if (condition) {
+        TEST_PASSED++;
+        fmt::print(fmt::fg(fmt::color::lime), "Test passed: ");
+        fmt::print(fmt::fg(fmt::color::yellow), "{}\n", name);
+    } else {
+        TEST_FAILED++;
+        fmt::print(fmt::fg(fmt::color::orange_red), "Test failed: ");
+        fmt::print(fmt::fg(fmt::color::yellow), "{}\n", name);
+    }
+}
+
 std::string myCustomFunc(std::string name) {
     return fmt::format("Hello, {}!", name);
 }
 
+struct TestVec2 {
+    double x, y;
+};
+
+struct TestPlayer {
+    std::string name;
+    int64_t score;
+    TestVec2 position;
+};
+
+static constexpr rift::NativeProperty VEC2_PROPERTIES[] = {
+    {"x", [](void const* v) -> rift::Value { return static_cast<TestVec2 const*>(v)->x; }},
+    {"y", [](void const* v) -> rift::Value { return static_cast<TestVec2 const*>(v)->y; }},
+};
+static rift::NativeType const VEC2_TYPE("Vec2", VEC2_PROPERTIES);
+
+static constexpr rift::NativeProperty PLAYER_PROPERTIES[] = {
+    {"name", [](void const* p) -> rift::Value { return rift::Value::borrowed(static_cast<TestPlayer const*>(p)->name); }},
+    {"score", [](void const* p) -> rift::Value { return static_cast<TestPlayer const*>(p)->score; }},
+    {"position", [](void const* p) -> rift::Value { return rift::Value::native(&static_cast<TestPlayer const*>(p)->position, VEC2_TYPE); }},
+};
+static rift::NativeType const PLAYER_TYPE("Player", PLAYER_PROPERTIES);
+
 int main() {
     rift::Config::get().makeFunction("myCustomFunc", myCustomFunc);
 
@@ -104,6 +149,7 @@ int main() {
     RIFT_TEST("{myCustomFunc('World')}", "Hello, World!");
     RIFT_TEST("{$'string interpolation: {2 + 2}'}", "string interpolation: 4");
     RIFT_TEST("{float('3.14')} {int('100')} {str(3.1415926)} {int('ABC')}", "3.14 100 3.14 0");
+    RIFT_TEST("{speed == 144} {float('1.5e3')} {float('-0.25')} {int('12abc')} {float('x') == float('x')}", "true 1500.00 -0.25 12 false", {{"speed", "144.0"}});
     RIFT_TEST("{precision(float('3.149268') * 1.5, 6)}", "4.723902");
     RIFT_TEST("{'*' * 5} {4 * '*'} {'*' * 3.0} {2.0 * '*'}", "***** **** *** **");
     RIFT_TEST("{!value} {!true} {!false} {!nullval}", "false false true true", {{"value", true}});
@@ -112,6 +158,317 @@ int main() {
     RIFT_TEST("{middlePad('#' * (progress * 4 / 10), 40, '-')} {progress}%", "----------####################---------- 50%", {{"progress", 50}});
     RIFT_TEST("{min(20, 40)}", "20");
     RIFT_EVAL("-1 * 'hello'", ""); // making sure string multiplication with negative number is empty
+    RIFT_TEST(
+        "{title + ' of the ' + title + ' ' + '-' * 3 + ' ' + 1.5 - 'e'} {items + 3 + items} {items} {title}",
+        "Th longst titl of th Th longst titl --- 1.50 [1, 2, 3, 1, 2] [1, 2] The longest title",
+        {{"title", "The longest title"}, {"items", rift::Array {1, 2}}}
+    ); // in place concatenation must leave the variables alone
+    RIFT_TEST(
+        "{player.stats.history[1]} {player.stats['score'] * 2} {player.missing.value} {player.name[0]}",
+        "20 84 null B",
+        {{"player", rift::Object {{"name", "Bob"}, {"stats", rift::Object {{"score", 42}, {"history", rift::Array {10, 20}}}}}}}
+    );
+    RIFT_TEST(
+        "{rows[1].name} {rows[0].tags[1]} {rows[0].name[2]} {rows[5].name} {rows[0]['tags'][0]} {rows['1'].name} {rows[0].tags.x}",
+        "Bob b n null a Bob null",
+        {{"rows", rift::Array {rift::Object {{"name", "Ann"}, {"tags", rift::Array {"a", "b"}}}, rift::Object {{"name", "Bob"}}}}}
+    ); // constant paths must behave like the accessors and indexers they replace
+
+    // Native objects
+    TestPlayer nativePlayer {"Alice", 10, {1.5, -2}};
+    rift::Object nativeVars {{"player", rift::Value::native(&nativePlayer, PLAYER_TYPE)}};
+    RIFT_TEST(
+        "{player.name} {player.score * 2} {player.position.x + player.position.y} {player['score']} {player.missing} {player}",
+        "Alice 20 -0.50 10 null {name: Alice, score: 10, position: {x: 1.50, y: -2.00}}",
+        nativeVars
+    );
+    nativePlayer.score = 25;
+    nativePlayer.position.x = 4;
+    RIFT_TEST("{player.score} {player.position.x} {player == player} {player.position == player}", "25 4.00 true false", nativeVars);
+    RIFT_CHECK("native objects cannot be added", rift::format("{player + 1}", nativeVars).isErr());
+
+    // Parser nesting, expressions are parsed without recursion and deep nesting is rejected
+    RIFT_EVAL("-2 ^ 2 + (1 ? 2 ? 3 : 4 : 5) * 2 ^ 3 ^ 0", 2.0);
+    RIFT_EVAL(std::string(100, '(') + "1 + 2" + std::string(100, ')'), 3);
+    RIFT_EVAL(std::string(100, '-') + "1", 1);
+    RIFT_CHECK("deep nesting is rejected",
+        rift::evaluate(std::string(10'000, '(') + "1" + std::string(10'000, ')')).unwrapErr().message().starts_with("ParseError: Expression nested too deeply")
+    );
+    RIFT_CHECK("deep prefix chains are rejected", rift::evaluate(std::string(10'000, '!') + "1").isErr());
+    auto repeat = [](std::string_view first, std::string_view step, size_t count) {
+        std::string result(first);
+        for (size_t i = 1; i < count; ++i) result += step;
+        return result;
+    };
+    RIFT_EVAL(repeat("a", " + a", 1'000), 1'000, {{"a", 1}});
+    RIFT_CHECK("long operator chains are rejected", rift::compile("{" + repeat("a", " + a", 10'000) + "}").isErr());
+    RIFT_CHECK("long accessor chains are rejected", rift::compile("{" + repeat("a", ".b", 10'000) + "}").isErr());
+    RIFT_CHECK("long index chains are rejected", rift::compile("{" + repeat("a", "[x]", 10'000) + "}").isErr());
+
+    // Lazy variables
+    int lazyCalls = 0;
+    rift::Object lazyVars {
+        {"time", rift::Value::lazy([&lazyCalls] { lazyCalls++; return rift::Value("1:23"); })},
+        {"stats", rift::Value::lazy([] { return rift::Value(rift::Object {{"best", 97}}); })},
+        {"unused", rift::Value::lazy([&lazyCalls] { lazyCalls += 100; return rift::Value(); })},
+    };
+    RIFT_TEST("{time} {time + '!'} {$'{time}'} {stats.best}%", "1:23 1:23! 1:23 97%", lazyVars);
+    RIFT_CHECK("lazy variables are resolved once per evaluation", lazyCalls == 2);
+    int memberCalls = 0;
+    rift::Object lazyMembers {
+        {"i", 1},
+        {"obj", rift::Object {
+            {"inner", rift::Value::lazy([&memberCalls] { memberCalls++; return rift::Value(rift::Object {{"name", "abc"}}); })},
+            {"list", rift::Array {1, rift::Value::lazy([] { return rift::Value(rift::Object {{"name", "def"}}); })}},
+            {"text", rift::Value::lazy([] { return rift::Value("abc"); })},
+        }},
+    };
+    RIFT_TEST(
+        "{obj.inner.name} {obj['inner']['name']} {obj.list[1].name} {obj.list[i]['name']} {obj.text == 'zzz'} {obj.text + 1}",
+        "abc abc def def false abc1", lazyMembers
+    );
+    RIFT_CHECK("lazy members are resolved once per evaluation", memberCalls == 2);
+    RIFT_CHECK("lazy members are not handed to the host", rift::evaluate("obj.text", lazyMembers).unwrap().isString());
+    auto lazyText = rift::Value::lazy([] { return rift::Value("abc"); });
+    RIFT_CHECK("operators resolve lazy operands",
+        (lazyText == rift::Value("zzz")).toBoolean() == false && (lazyText + rift::Value(1)).unwrap().toString() == "abc1"
+    );
+
+    // Short-circuit evaluation and lazy parameters
+    int countedCalls = 0;
+    rift::Config::get().registerFunction("counted", [&countedCalls](std::span<rift::Value const> args) -> rift::RuntimeFuncResult {
+        countedCalls++;
+        return geode::Ok(args.empty() ? rift::Value() : args[0]);
+    });
+    rift::Object flags {{"yes", true}, {"no", false}, {"name", "World"}};
+    RIFT_TEST("{no && counted(1)} {yes || counted(2)} {no || counted(0)} {yes && counted('x')}", "false true false true", flags);
+    RIFT_CHECK("logical operators skip the right side", countedCalls == 4);
+    RIFT_TEST("{coalesce(missing, name, counted(1))} {choose(1, counted(2), 'b', counted(3))} {choose(5, 1)}", "World b null", flags);
+    RIFT_CHECK("lazy parameters skip unused arguments", countedCalls == 4);
+    RIFT_TEST("{coalesce(missing, counted(5))} {coalesce(counted(null), 'fallback')}", "5 fallback", flags);
+    RIFT_CHECK("lazy parameters evaluate used arguments once", countedCalls == 8);
+    RIFT_CHECK("errors in used lazy arguments are reported", rift::format("{coalesce(undefined(), 1)}").isErr());
+    RIFT_CHECK("errors in skipped lazy arguments are not", rift::format("{coalesce(1, undefined())} {no && undefined()}", flags).unwrapOr("") == "1 false");
+    rift::Config::get().registerFunction("twice", [](std::span<rift::Value const> args) -> rift::RuntimeFuncResult {
+        return geode::Ok(args[0].toInteger() + args[0].resolve().toInteger());
+    }, false, rift::ALL_LAZY);
+    countedCalls = 0;
+    RIFT_TEST("{twice(counted(21))}", "42");
+    RIFT_CHECK("lazy arguments are evaluated once per call", countedCalls == 2);
+    rift::Config::get().registerFunction("wrap", [](std::span<rift::Value const> args) -> rift::RuntimeFuncResult {
+        return geode::Ok(rift::Array {args[0], rift::Object {{"arg", args[0]}}});
+    }, false, rift::ALL_LAZY);
+    RIFT_TEST("{wrap(name + '!')[0]} {wrap(counted(7))[1].arg} {wrap(1)}", "World! 7 [1, {arg: 1}]", flags);
+
+    // Bytecode engine
+    RIFT_TEST("{('sq' + 'rt')(16)} {false ? missing() : 'lazy'}", "4.00 lazy");
+    auto script = rift::compile("{1 + missing(2)}").unwrap();
+    auto treeResult = script->eval();
+    script->setEngine(rift::Script::Engine::Bytecode);
+    auto bytecodeResult = script->eval();
+    RIFT_CHECK(
+        "bytecode errors match the tree walker",
+        treeResult.isErr() && bytecodeResult.isErr()
+        && treeResult.unwrapErr().message() == bytecodeResult.unwrapErr().message()
+        && treeResult.unwrapErr().index() == bytecodeResult.unwrapErr().index()
+    );
+
+    // Optimizer
+    auto debugTree = [](std::string_view source, rift::OptimizationLevel level, bool directMode = false) {
+        auto res = rift::compile(source, directMode, level);
+        return res ? res.unwrap()->toDebugString() : std::string(res.unwrapErr().message());
+    };
+    RIFT_CHECK("folds literal operators", debugTree("{'a' + 'b'}", rift::OptimizationLevel::Basic) == "ValueNode(ab)");
+    RIFT_CHECK("merges static segments", debugTree("Hello, {'World'}! {2 * 3}", rift::OptimizationLevel::Basic) == "SegmentNode(\"Hello, World! 6\")");
+    RIFT_CHECK("prunes literal ternaries", debugTree("{1 > 2 ? a : b}", rift::OptimizationLevel::Basic) == "IdentifierNode(b)");
+    RIFT_CHECK("keeps variables", debugTree("{a}{'b'}{c}", rift::OptimizationLevel::Basic) == "RootNode(IdentifierNode(a), SegmentNode(\"b\"), IdentifierNode(c))");
+    RIFT_CHECK("keeps failing expressions", debugTree("'a' / 2", rift::OptimizationLevel::Basic, true).starts_with("BinaryNode"));
+    RIFT_CHECK("basic level keeps globals and calls", debugTree("PI * sqrt(4)", rift::OptimizationLevel::Basic, true).starts_with("BinaryNode"));
+    RIFT_CHECK("aggressive level folds globals and pure calls", debugTree("PI * sqrt(4)", rift::OptimizationLevel::Aggressive, true) == "ValueNode(6.28)");
+    RIFT_CHECK("aggressive level keeps impure calls", debugTree("random(1, 2)", rift::OptimizationLevel::Aggressive, true).starts_with("CallNode"));
+    RIFT_CHECK("none level keeps the tree", debugTree("1 + 2", rift::OptimizationLevel::None, true).starts_with("BinaryNode"));
+    RIFT_CHECK("collapses access chains", debugTree("{a.b[0]['c'].d}", rift::OptimizationLevel::Basic) == "PathNode(IdentifierNode(a), .b, [0], [c], .d)");
+    RIFT_CHECK("keeps dynamic indices", debugTree("{a.b[i].c}", rift::OptimizationLevel::Basic) == "AccessorNode(IndexerNode(PathNode(IdentifierNode(a), .b), IdentifierNode(i)), c)");
+    RIFT_CHECK("reports removed nodes", rift::compile("A{1 + 2 * 3}B", false).unwrap()->removedNodes() == 7);
+
+    // Sub-template interpolation
+    RIFT_TEST("{$'{$\"{1 + 1}\"} {name}'}", "2 World", {{"name", "World"}});
+    RIFT_CHECK("recursive interpolation is rejected", rift::format("{$x}", {{"x", "{$x}"}}).isErr());
+    RIFT_CHECK("mutually recursive interpolation is rejected", rift::format("{$a}", {{"a", "{$b}"}, {"b", "{$a}"}}).isErr());
+    rift::Object chain;
+    for (size_t i = 0; i <= rift::Visitor::MAX_INTERPOLATION_DEPTH; ++i) {
+        chain[fmt::format("v{}", i)] = fmt::format("{{$v{}}}", i + 1);
+    }
+    RIFT_CHECK("interpolation depth is limited", rift::format("{$v0}", chain).isErr());
+
+    // Script cache
+    auto& cache = rift::ScriptCache::get();
+    cache.clear();
+    cache.resetStats();
+    (void) rift::format("{1 + 1}");
+    RIFT_CHECK("format caches compiled script", rift::format("{1 + 1}").unwrapOr("") == "2" && cache.stats().hits == 1 && cache.stats().misses == 1);
+    RIFT_CHECK("cache is keyed by mode", rift::evaluate("{1 + 1}").isErr() && cache.stats().misses == 2 && cache.stats().entries == 1);
+    RIFT_CHECK("cache invalidate", cache.invalidate("{1 + 1}") && !cache.invalidate("{1 + 1}") && cache.stats().entries == 0);
+    (void) rift::format("Evicted {1 + 1}");
+    cache.setCapacity(0);
+    RIFT_CHECK("cache evicts over capacity", cache.stats().entries == 0 && cache.stats().evictions == 1);
+    RIFT_CHECK("disabled cache still formats", rift::format("Uncached {2 + 2}").unwrapOr("") == "Uncached 4" && cache.stats().entries == 0);
+    cache.setCapacity(rift::ScriptCache::DEFAULT_CAPACITY);
+
+    // Variable schema
+    rift::VariableSchema schema = {"name", "number"};
+    auto slotted = rift::compile("Hello {name}, {number * 2} {$'{name}!'} {PI > 3}", schema, false, rift::OptimizationLevel::Aggressive).unwrap();
+    auto frame = slotted->makeFrame();
+    frame[schema.slot("name")] = "World";
+    frame[schema.slot("number")] = 21;
+    for (auto engine : { rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode }) {
+        slotted->setEngine(engine);
+        auto name = ENGINE_NAMES[static_cast<size_t>(engine)];
+        RIFT_CHECK(fmt::format("slot frame [{}]", name), slotted->run(frame).unwrapOr("") == "Hello World, 42 World! true");
+        RIFT_CHECK(fmt::format("object fallback [{}]", name), slotted->run({{"name", "You"}, {"number", 1}}).unwrapOr("") == "Hello You, 2 You! true");
+    }
+    rift::VariableSchema pathSchema = {"pos"};
+    auto slottedPath = rift::compile("{pos.x + pos.y} {pos.x}", pathSchema).unwrap();
+    std::vector<rift::Value> pathFrame = {rift::Object {{"x", 1}, {"y", 2}}};
+    for (auto engine : { rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode }) {
+        slottedPath->setEngine(engine);
+        RIFT_CHECK(fmt::format("paths start at slots [{}]", ENGINE_NAMES[static_cast<size_t>(engine)]), slottedPath->run(pathFrame).unwrapOr("") == "3 1");
+    }
+    RIFT_CHECK("schema resolves identifiers", slotted->toDebugString().find("IdentifierNode(name, slot=0)") != std::string::npos);
+    RIFT_CHECK("unknown name has no slot", schema.slot("missing") == rift::VariableSchema::NO_SLOT && schema.add("number") == 1);
+
+    // Type inference, kernels must agree with the generic operators even when a declared type is wrong
+    rift::VariableSchema typed, untyped = {"hp", "speed", "tag"};
+    typed.add("hp", rift::Value::Type::Integer);
+    typed.add("speed", rift::Value::Type::Float);
+    typed.add("tag", rift::Value::Type::String);
+    constexpr std::string_view KERNEL_SOURCE = "{hp * 2 + 1} {hp / 4} {hp / 0} {-hp % 0} {hp ^ 2} {speed * hp} {speed / 0} "
+                                               "{hp > speed} {hp == 12} {tag == 'boss'} {tag != tag} {sum(hp, 1) / 2}";
+    auto specialized = rift::compile(KERNEL_SOURCE, typed).unwrap();
+    auto generic = rift::compile(KERNEL_SOURCE, untyped).unwrap();
+    std::vector<rift::Value> goodFrame = {12, 2.5, "boss"}, wrongFrame = {12.5, 3, 7};
+    RIFT_CHECK("typed slots are reported", typed.type(0) == rift::Value::Type::Integer && !untyped.type(0).has_value());
+    for (auto engine : { rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode }) {
+        specialized->setEngine(engine);
+        generic->setEngine(engine);
+        auto name = ENGINE_NAMES[static_cast<size_t>(engine)];
+        RIFT_CHECK(fmt::format("kernels match generic operators [{}]", name),
+                   specialized->run(goodFrame).unwrapOr("") == "25 3 inf nan 144.00 30.00 inf true true true false 6.50");
+        RIFT_CHECK(fmt::format("kernels fall back on mismatched types [{}]", name),
+                   specialized->run(wrongFrame).unwrapOr("a") == generic->run(wrongFrame).unwrapOr("b"));
+    }
+
+    // Function binding
+    RIFT_CHECK("unknown functions are reported when checked", rift::compile("{1 + later(2)}", false, rift::OptimizationLevel::Basic, true).isErr());
+    auto bound = rift::compile("{later(2)}").unwrap();
+    RIFT_CHECK("unknown functions fail at runtime by default", bound->run().isErr());
+    rift::Config::get().registerFunction("later", [](std::span<rift::Value const> args) -> rift::RuntimeFuncResult {
+        return geode::Ok(rift::Value(args[0].toInteger() * 10));
+    });
+    RIFT_CHECK("registering a function rebinds call sites", bound->run().unwrapOr("") == "20");
+    rift::Config::get().registerFunction("later", [](std::span<rift::Value const> args) -> rift::RuntimeFuncResult {
+        return geode::Ok(rift::Value(args[0].toInteger() * 100));
+    });
+    bound->setEngine(rift::Script::Engine::Bytecode);
+    RIFT_CHECK("replacing a function rebinds call sites", bound->run().unwrapOr("") == "200");
+
+    // Arena
+    size_t destroyed = 0;
+    struct Tracked {
+        size_t& counter;
+        ~Tracked() { counter++; }
+    };
+    {
+        rift::Arena arena;
+        for (size_t i = 0; i < 1000; ++i) {
+            (void) arena.make<Tracked>(destroyed);
+        }
+        auto moved = std::move(arena);
+        RIFT_CHECK("arena grows in blocks", moved.capacity() >= moved.used() && moved.used() >= 1000 * sizeof(Tracked));
+    }
+    RIFT_CHECK("arena runs destructors", destroyed == 1000);
+
+    // Output sink
+    auto sink = std::move(rift::compile("Hello, {name}! {number * 2}").unwrap());
+    for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+        sink->setEngine(engine);
+        std::string out = "stale";
+        bool first = sink->runInto(out, {{"name", "World"}, {"number", 2}}).isOk() && out == "Hello, World! 4";
+        auto capacity = out.capacity();
+        bool second = sink->runInto(out, {{"name", "Bob"}, {"number", 3}}).isOk() && out == "Hello, Bob! 6";
+        RIFT_CHECK(fmt::format("runInto reuses the buffer [{}]", ENGINE_NAMES[static_cast<size_t>(engine)]),
+                   first && second && out.capacity() == capacity);
+    }
+    // Borrowed strings
+    auto borrowedText = rift::Value::borrowed("borrowed");
+    auto ownedText = borrowedText;
+    ownedText.detach();
+    RIFT_CHECK("borrowed strings compare like owned ones",
+               borrowedText.isBorrowed() && !ownedText.isBorrowed() && (borrowedText == rift::Value("borrowed")).toBoolean());
+    rift::Value escaped;
+    {
+        auto script = std::move(rift::compile("flag ? 'static ' + 'text' : 'other'", true, rift::OptimizationLevel::None).unwrap());
+        for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+            script->setEngine(engine);
+            escaped = script->eval(rift::Object {{"flag", false}}).unwrapOrDefault();
+        }
+    }
+    RIFT_CHECK("eval results outlive the script", !escaped.isBorrowed() && escaped.toString() == "other");
+
+    // Shared containers
+    rift::Value history = rift::Array {1, 2, 3};
+    auto shared = history;
+    bool sharesPayload = &shared.getArray() == &history.getArray();
+    shared[1] = 20;
+    RIFT_CHECK("copies share arrays until written to",
+               sharesPayload && history[1].getInteger() == 2 && shared[1].getInteger() == 20);
+    rift::Value stats = rift::Object {{"history", history}};
+    auto lookup = stats.at("history");
+    RIFT_CHECK("reading members does not copy containers", &lookup.getArray() == &history.getArray());
+    rift::Object ordered = {{"zeta", 1}, {"alpha", 2}, {"zeta", 3}};
+    for (int i = 0; i < 100; ++i) {
+        ordered[fmt::format("key{}", i)] = i;
+    }
+    ordered.erase("alpha");
+    RIFT_CHECK("objects keep insertion order", rift::Value(ordered).toString().starts_with("{zeta: 1, key0: 0, key1: 1")
+               && ordered.size() == 101 && ordered.find(std::string_view("key99"))->second.getInteger() == 99
+               && !ordered.contains("alpha"));
+    RIFT_CHECK("objects find keys by precomputed hash", ordered.find("key42", rift::Object::hash("key42"))->second.getInteger() == 42
+               && ordered.find("alpha", rift::Object::hash("alpha")) == ordered.end());
+    rift::Object assigned {{"source", std::string(100, 'x')}};
+    rift::Value assignedValue = assigned;
+    for (size_t i = 0; i < 100; ++i) {
+        assigned[fmt::format("copy{}", i)] = assigned["source"];
+        assignedValue[fmt::format("copy{}", i)] = assignedValue[std::string_view("source")];
+    }
+    RIFT_CHECK("inserting keeps the reference being assigned from",
+        std::ranges::all_of(assigned, [](auto const& pair) { return pair.second.getStringView() == std::string(100, 'x'); })
+        && std::ranges::all_of(assignedValue.getObject(), [](auto const& pair) { return pair.second.getStringView() == std::string(100, 'x'); })
+    );
+    rift::Value shortText = "fits inline!!!";
+    rift::Value longText = std::string(100, 'x');
+    auto longCopy = longText;
+    RIFT_CHECK("inline and shared strings", shortText.getStringView() == "fits inline!!!" && longCopy.getStringView().size() == 100
+               && longCopy.getStringView().data() == longText.getStringView().data());
+
+    auto precise = std::move(rift::compile("{1.5 * 3} {pi} {number}").unwrap());
+    for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+        precise->setEngine(engine);
+        auto before = precise->run({{"pi", 3.14159265}, {"number", -42}}).unwrapOr("");
+        precise->setPrecision(4);
+        auto after = precise->run({{"pi", 3.14159265}, {"number", -42}}).unwrapOr("");
+        precise->setPrecision(rift::Value::DEFAULT_PRECISION);
+        RIFT_CHECK(fmt::format("script float precision [{}]", ENGINE_NAMES[static_cast<size_t>(engine)]),
+                   before == "4.50 3.14 -42" && after == "4.5000 3.1416 -42");
+    }
+
+    auto failing = std::move(rift::compile("before {missing()} after").unwrap());
+    for (auto engine : {rift::Script::Engine::TreeWalker, rift::Script::Engine::Bytecode}) {
+        failing->setEngine(engine);
+        std::string out;
+        RIFT_CHECK(fmt::format("runInto reports errors [{}]", ENGINE_NAMES[static_cast<size_t>(engine)]),
+                   failing->runInto(out).isErr());
+    }
 
     fmt::println("\nResults:\nTests passed: {}/{}\nTests failed: {}/{}", TEST_PASSED, TEST_COUNT, TEST_FAILED, TEST_COUNT);
     return TEST_FAILED;